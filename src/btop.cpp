@@ -21,6 +21,7 @@ tab-size = 4
 #include <algorithm>
 #include <csignal>
 #include <clocale>
+#include <cstring>
 #include <filesystem>
 #include <iterator>
 #include <optional>
@@ -62,6 +63,7 @@ tab-size = 4
 #include "btop_input.hpp"
 #include "btop_theme.hpp"
 #include "btop_draw.hpp"
+#include "btop_events.hpp"
 #include "btop_menu.hpp"
 #ifdef AZEROTHCORE_SUPPORT
 #include "btop_azerothcore.hpp"
@@ -133,10 +135,7 @@ void term_resize(bool force) {
 		return;
 	}
 	atomic_lock lck(resizing, true);
-	if (auto refreshed = Term::refresh(true); refreshed or force) {
-		if (force and refreshed) force = false;
-	}
-	else return;
+	if (not Term::refresh(true) and not force) return;
 #if defined(GPU_SUPPORT) && defined(AZEROTHCORE_SUPPORT)
 	static const array<string, 11> all_boxes = {"azerothcore", "gpu5", "cpu", "mem", "net", "proc", "gpu0", "gpu1", "gpu2", "gpu3", "gpu4"};
 #elif defined(GPU_SUPPORT)
@@ -155,61 +154,58 @@ void term_resize(bool force) {
 	auto min_size = Term::get_min_size(boxes);
 	auto minWidth = min_size.at(0), minHeight = min_size.at(1);
 
-	while (not force or (Term::width < minWidth or Term::height < minHeight)) {
-		sleep_ms(100);
-		if (Term::width < minWidth or Term::height < minHeight) {
-			int width = Term::width, height = Term::height;
-			cout << fmt::format("{clear}{bg_black}{fg_white}"
-					"{mv1}Terminal size too small:"
-					"{mv2} Width = {fg_width}{width} {fg_white}Height = {fg_height}{height}"
-					"{mv3}{fg_white}Needed for current config:"
-					"{mv4}Width = {minWidth} Height = {minHeight}",
-					"clear"_a = Term::clear, "bg_black"_a = Global::bg_black, "fg_white"_a = Global::fg_white,
-					"mv1"_a = Mv::to((height / 2) - 2, (width / 2) - 11),
-					"mv2"_a = Mv::to((height / 2) - 1, (width / 2) - 10),
-						"fg_width"_a = (width < minWidth ? Global::fg_red : Global::fg_green),
-						"width"_a = width,
-						"fg_height"_a = (height < minHeight ? Global::fg_red : Global::fg_green),
-						"height"_a = height,
-					"mv3"_a = Mv::to((height / 2) + 1, (width / 2) - 12),
-					"mv4"_a = Mv::to((height / 2) + 2, (width / 2) - 10),
-						"minWidth"_a = minWidth,
-						"minHeight"_a = minHeight
-			) << std::flush;
-
-			bool got_key = false;
-			for (; not Term::refresh() and not got_key; got_key = Input::poll(10));
-			if (got_key) {
-				auto key = Input::get();
-				if (key == "q")
-					clean_quit(0);
-			#ifdef AZEROTHCORE_SUPPORT
-				else if (key == "a" or key == "0") {
-					// Toggle AzerothCore box (index 0)
+	//? Settling is left to the caller, this only waits while the terminal is too small
+	while (Term::width < minWidth or Term::height < minHeight) {
+		int width = Term::width, height = Term::height;
+		cout << fmt::format("{clear}{bg_black}{fg_white}"
+				"{mv1}Terminal size too small:"
+				"{mv2} Width = {fg_width}{width} {fg_white}Height = {fg_height}{height}"
+				"{mv3}{fg_white}Needed for current config:"
+				"{mv4}Width = {minWidth} Height = {minHeight}",
+				"clear"_a = Term::clear, "bg_black"_a = Global::bg_black, "fg_white"_a = Global::fg_white,
+				"mv1"_a = Mv::to((height / 2) - 2, (width / 2) - 11),
+				"mv2"_a = Mv::to((height / 2) - 1, (width / 2) - 10),
+					"fg_width"_a = (width < minWidth ? Global::fg_red : Global::fg_green),
+					"width"_a = width,
+					"fg_height"_a = (height < minHeight ? Global::fg_red : Global::fg_green),
+					"height"_a = height,
+				"mv3"_a = Mv::to((height / 2) + 1, (width / 2) - 12),
+				"mv4"_a = Mv::to((height / 2) + 2, (width / 2) - 10),
+					"minWidth"_a = minWidth,
+					"minHeight"_a = minHeight
+		) << std::flush;
+
+		bool got_key = false;
+		for (; not Term::refresh() and not got_key; got_key = Input::poll(10));
+		if (got_key) {
+			auto key = Input::get();
+			if (key == "q")
+				clean_quit(0);
+		#ifdef AZEROTHCORE_SUPPORT
+			else if (key == "a" or key == "0") {
+				// Toggle AzerothCore box (index 0)
+				Config::current_preset = -1;
+				Config::toggle_box("azerothcore");
+				boxes = Config::getS("shown_boxes");
+			}
+		#endif
+			else if (key.size() == 1 and isint(key)) {
+				auto intKey = stoi(key);
+			#ifdef GPU_SUPPORT
+				if ((intKey == 0 and Gpu::count >= 5) or (intKey >= 5 and intKey - 4 <= Gpu::count)) {
+			#else
+				if (intKey > 0 and intKey < 5) {
+			#endif
+					const auto& box = all_boxes.at(intKey);
 					Config::current_preset = -1;
-					Config::toggle_box("azerothcore");
+					Config::toggle_box(box);
 					boxes = Config::getS("shown_boxes");
 				}
-			#endif
-				else if (key.size() == 1 and isint(key)) {
-					auto intKey = stoi(key);
-				#ifdef GPU_SUPPORT
-					if ((intKey == 0 and Gpu::count >= 5) or (intKey >= 5 and intKey - 4 <= Gpu::count)) {
-				#else
-					if (intKey > 0 and intKey < 5) {
-				#endif
-						const auto& box = all_boxes.at(intKey);
-						Config::current_preset = -1;
-						Config::toggle_box(box);
-						boxes = Config::getS("shown_boxes");
-					}
-				}
 			}
-			min_size = Term::get_min_size(boxes);
-			minWidth = min_size.at(0);
-			minHeight = min_size.at(1);
 		}
-		else if (not Term::refresh()) break;
+		min_size = Term::get_min_size(boxes);
+		minWidth = min_size.at(0);
+		minHeight = min_size.at(1);
 	}
 
 	Input::interrupt();
@@ -220,20 +216,23 @@ void clean_quit(int sig) {
 	if (Global::quitting) return;
 	Global::quitting = true;
 	Runner::stop();
+	//? Threads are never cancelled, one that does not finish in time is left to the exit below
 	if (Global::_runner_started) {
 	#if defined __APPLE__ || defined __OpenBSD__ || defined __NetBSD__
 		if (pthread_join(Runner::runner_id, nullptr) != 0) {
 			Logger::warning("Failed to join _runner thread on exit!");
-			pthread_cancel(Runner::runner_id);
 		}
 	#else
 		constexpr struct timespec ts { .tv_sec = 5, .tv_nsec = 0 };
 		if (pthread_timedjoin_np(Runner::runner_id, nullptr, &ts) != 0) {
 			Logger::warning("Failed to join _runner thread on exit!");
-			pthread_cancel(Runner::runner_id);
 		}
 	#endif
 	}
+#ifdef AZEROTHCORE_SUPPORT
+	//? Cancels the commands in flight, so this returns within tens of ms and leaves no channels open
+	::AzerothCore::cleanup();
+#endif
 
 #ifdef GPU_SUPPORT
 	Gpu::Nvml::shutdown();
@@ -658,17 +657,16 @@ namespace Runner {
 
 			#ifdef AZEROTHCORE_SUPPORT
 				//? AZEROTHCORE
-				if (Config::getB("azerothcore_enabled")) {
+				if (Config::getB(Config::BoolKey::azerothcore_enabled)) {
 					try {
 						if (Global::debug) debug_timer("azerothcore", collect_begin);
 
-						//? Start collect
+						//? Hand a cycle to the collector thread, drawing never waits for it
 						try {
 							if (not conf.no_update) ::AzerothCore::collect();
 						}
 						catch (const std::exception& e) {
 							Logger::error("AzerothCore::collect() -> " + string{e.what()});
-							::AzerothCore::current_data.error = "Collect error: " + string{e.what()};
 						}
 
 						if (Global::debug) debug_timer("azerothcore", draw_begin);
@@ -772,7 +770,7 @@ namespace Runner {
 			}
 
 			//? If overlay isn't empty, print output without color and then print overlay on top
-			const bool term_sync = Config::getB("terminal_sync");
+			const bool term_sync = Config::getB(Config::BoolKey::terminal_sync);
 			cout << (term_sync ? Term::sync_start : "") << (conf.overlay.empty()
 					? output
 					: (output.empty() ? "" : Fx::ub + Theme::c("inactive_fg") + Fx::uncolor(output)) + conf.overlay)
@@ -785,33 +783,30 @@ namespace Runner {
 
 	//* Runs collect and draw in a secondary thread, unlocks and locks config to update cached values
 	void run(const string& box, bool no_update, bool force_redraw) {
-		atomic_wait_for(active, true, 5000);
+		//? The runner only draws, network waits live on the collector thread where they can be cancelled.
+		//? A runner still busy after 5s is stalled: its draws are skipped, without waiting again, until it
+		//? finishes. A thread is never cancelled half way through its work.
+		static bool stalled = false;
+		atomic_wait_for(active, true, stalled ? 0 : 5000);
 		if (active) {
-			Logger::error("Stall in Runner thread, restarting!");
-			active = false;
-			// exit(1);
-			pthread_cancel(Runner::runner_id);
-
-			// Wait for the thread to actually terminate before creating a new one
-			void* thread_result;
-			int join_result = pthread_join(Runner::runner_id, &thread_result);
-			if (join_result != 0) {
-				Logger::warning("Failed to join cancelled thread: " + string(strerror(join_result)));
-			}
-
-			if (pthread_create(&Runner::runner_id, nullptr, &Runner::_runner, nullptr) != 0) {
-				Global::exit_error_msg = "Failed to re-create _runner thread!";
-				clean_quit(1);
-			}
+			if (not stalled) Logger::warning("Runner thread busy for over 5s, skipping draws until it finishes");
+			stalled = true;
+			return;
+		}
+		if (stalled) {
+			//? A skipped run may have been a full redraw
+			Logger::info("Runner thread finished after a stall");
+			stalled = false;
+			force_redraw = true;
 		}
 		if (stopping or Global::resized) return;
 
 		if (box == "overlay") {
-			const bool term_sync = Config::getB("terminal_sync");
+			const bool term_sync = Config::getB(Config::BoolKey::terminal_sync);
 			cout << (term_sync ? Term::sync_start : "") << Global::overlay << (term_sync ? Term::sync_end : "") << flush;
 		}
 		else if (box == "clock") {
-			const bool term_sync = Config::getB("terminal_sync");
+			const bool term_sync = Config::getB(Config::BoolKey::terminal_sync);
 			cout << (term_sync ? Term::sync_start : "") << Global::clock << (term_sync ? Term::sync_end : "") << flush;
 		}
 		else {
@@ -821,7 +816,7 @@ namespace Runner {
 			current_conf = {
 				(box == "all" ? Config::current_boxes : vector{box}),
 				no_update, force_redraw,
-				(not Config::getB("tty_mode") and Config::getB("background_update")),
+				(not Config::getB(Config::BoolKey::tty_mode) and Config::getB(Config::BoolKey::background_update)),
 				Global::overlay,
 				Global::clock
 			};
@@ -865,6 +860,129 @@ namespace Runner {
 
 }
 
+#ifdef AZEROTHCORE_SUPPORT
+//* The azerothcore_* options as server settings
+static ::AzerothCore::ServerConfig azerothcore_config() {
+	::AzerothCore::ServerConfig server;
+	server.ssh_host = Config::getS("azerothcore_ssh_host");
+	server.db_host = Config::getS("azerothcore_db_host");
+	server.db_user = Config::getS("azerothcore_db_user");
+	server.db_pass = Config::getS("azerothcore_db_pass");
+	server.db_name = Config::getS("azerothcore_db_name");
+	server.container = Config::getS("azerothcore_container");
+	server.config_path = Config::getS("azerothcore_config_path");
+	server.worldserver_db_user = Config::getS("azerothcore_worldserver_db_user");
+	server.realms = Config::getS("azerothcore_realms");
+	server.ra_username = Config::getS("azerothcore_ra_username");
+	server.ra_password = Config::getS("azerothcore_ra_password");
+	server.rtt_budget_ms = Config::getI("azerothcore_rtt_budget_ms");
+	server.sample_margin = Config::getI("azerothcore_sample_margin");
+	server.table_limit_mb = Config::getI("azerothcore_table_limit_mb");
+	server.eco_idle_s = Config::getI("azerothcore_eco_idle_s");
+	server.eco_ms = Config::getI("azerothcore_eco_ms");
+	return server;
+}
+#endif
+
+//* Config hot reload: set the keys changed in the config file and refresh only what depends on them
+static void reload_config(bool low_color) {
+	vector<string> load_warnings;
+	vector<string_view> changed;
+	{
+		atomic_lock lck(Global::init_conf);
+		changed = Config::reload(Config::conf_file, load_warnings);
+	}
+	for (const auto& err_str : load_warnings) Logger::warning(err_str);
+	if (changed.empty()) {
+		Logger::debug("Config reload: nothing changed");
+		return;
+	}
+
+	//? Values set while the runner was drawing wait in the config cache until it is idle
+	Config::unlock();
+
+	bool theme = false, layout = false, clock = false;
+#ifdef AZEROTHCORE_SUPPORT
+	bool server = false, reconnect = false;
+#endif
+	string names;
+	for (const auto name : changed) {
+		names += (names.empty() ? "" : " ") + string{name};
+		if (is_in(name, "color_theme", "theme_background", "truecolor"))
+			theme = true;
+		else if (name == "log_level") {
+			if (not Global::debug) Logger::set(Config::getS("log_level"));
+		}
+		else if (name == "clock_format")
+			clock = true;
+		//? The main loop re-arms its tick when update_ms differs
+		else if (name == "update_ms")
+			continue;
+	#ifdef AZEROTHCORE_SUPPORT
+		else if (name == "azerothcore_enabled")
+			Logger::warning("azerothcore_enabled takes effect on the next start");
+		else if (name.starts_with("azerothcore_")) {
+			server = true;
+			if (not is_in(name, "azerothcore_rtt_budget_ms", "azerothcore_table_limit_mb", "azerothcore_eco_idle_s", "azerothcore_eco_ms"))
+				reconnect = true;
+		}
+	#endif
+		//? Anything else changes how the boxes are laid out or drawn
+		else
+			layout = true;
+	}
+	Logger::info("Config reloaded, changed: " + names);
+
+#ifdef AZEROTHCORE_SUPPORT
+	//? The panes follow with the next published snapshot
+	if (server) ::AzerothCore::reconfigure(azerothcore_config(), reconnect);
+#endif
+
+	if (theme) {
+		Config::set("lowcolor", (low_color ? true : not Config::getB("truecolor")));
+		Theme::updateThemes();
+		Theme::setTheme();
+		Draw::banner_gen(0, 0, false, true);
+	}
+	//? Repainted by the resize path, which also covers boxes that no longer fit
+	if (theme or layout) {
+		if (v_contains(changed, "shown_boxes") and not Config::set_boxes(Config::getS("shown_boxes")))
+			Logger::warning("Invalid box name(s) in shown_boxes, keeping the boxes shown");
+		Global::resized = true;
+	}
+	else if (clock and Draw::update_clock(true)) {
+		Runner::run("clock");
+	}
+}
+
+#ifdef AZEROTHCORE_SUPPORT
+//* --advise: print the index advisor report
+static int run_advisor() {
+	auto report = ::AzerothCore::query->advise();
+	for (const auto& line : report.lines()) fmt::println("{}", line);
+	return report.error.empty() ? 0 : 1;
+}
+
+//* --install-summary: show the DDL, ask, then create the summary table and its events
+static int run_summary_install() {
+	fmt::println("The following statements will be run against {}:\n", ::AzerothCore::config.db_name);
+	for (const auto& statement : ::AzerothCore::query->summary_ddl()) fmt::println("{}\n", statement);
+	fmt::print("Install the summary table? [y/N] ");
+	string answer;
+	std::getline(std::cin, answer);
+	if (answer != "y" and answer != "Y") {
+		fmt::println("Aborted, nothing was changed");
+		return 1;
+	}
+	if (not ::AzerothCore::query->install_summary()) {
+		fmt::println("{}error:{} The summary table or its refresh event could not be created, check the DB user's CREATE and EVENT privileges", Fx::b, Fx::reset);
+		return 1;
+	}
+	fmt::println("Installed. bottop reads it once the event has run and event_scheduler is ON");
+	return 0;
+}
+#endif
+
 static auto configure_tty_mode(std::optional<bool> force_tty) {
 	if (force_tty.has_value()) {
 		Config::set("tty_mode", force_tty.value());
@@ -988,6 +1106,27 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 	//? Config init
 	init_config(cli.low_color, cli.filter);
 
+	//? One-shot database tools, run and exit before the terminal is taken over
+	if (cli.advise or cli.install_summary) {
+	#ifdef AZEROTHCORE_SUPPORT
+		::AzerothCore::config = azerothcore_config();
+		::AzerothCore::enabled = true;
+		::AzerothCore::init();
+		int ret = 1;
+		if (not ::AzerothCore::query)
+			fmt::println("{}error:{} AzerothCore monitoring failed to initialize", Fx::b, Fx::reset);
+		else if (cli.advise)
+			ret = run_advisor();
+		else
+			ret = run_summary_install();
+		::AzerothCore::cleanup();
+		return ret;
+	#else
+		fmt::println("{}error:{} --advise and --install-summary require a build with AzerothCore support", Fx::b, Fx::reset);
+		return 1;
+	#endif
+	}
+
 	//? Try to find and set a UTF-8 locale
 	if (std::setlocale(LC_ALL, "") != nullptr and not std::string_view { std::setlocale(LC_ALL, "") }.contains(";")
 	and str_to_upper(s_replace((string)std::setlocale(LC_ALL, ""), "-", "")).ends_with("UTF8")) {
@@ -1093,15 +1232,7 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 #ifdef AZEROTHCORE_SUPPORT
 	//? Initialize AzerothCore monitoring if enabled
 	if (Config::getB("azerothcore_enabled")) {
-		::AzerothCore::config.ssh_host = Config::getS("azerothcore_ssh_host");
-		::AzerothCore::config.db_host = Config::getS("azerothcore_db_host");
-		::AzerothCore::config.db_user = Config::getS("azerothcore_db_user");
-		::AzerothCore::config.db_pass = Config::getS("azerothcore_db_pass");
-		::AzerothCore::config.db_name = Config::getS("azerothcore_db_name");
-		::AzerothCore::config.container = Config::getS("azerothcore_container");
-		::AzerothCore::config.config_path = Config::getS("azerothcore_config_path");
-		::AzerothCore::config.ra_username = Config::getS("azerothcore_ra_username");
-		::AzerothCore::config.ra_password = Config::getS("azerothcore_ra_password");
+		::AzerothCore::config = azerothcore_config();
 		::AzerothCore::enabled = true;
 		try {
 			::AzerothCore::init();
@@ -1141,10 +1272,16 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 	std::signal(SIGBUS, _crash_handler);
 	std::signal(SIGILL, _crash_handler);
 
+	//? Signals for the event loop are blocked in every thread and read from its signalfd instead,
+	//? the handlers above only run while Input::poll() unblocks them in its pselect
 	sigset_t mask;
 	sigemptyset(&mask);
-	sigaddset(&mask, SIGUSR1);
+	for (int sig : {SIGUSR1, SIGUSR2, SIGWINCH, SIGTERM}) sigaddset(&mask, sig);
 	pthread_sigmask(SIG_BLOCK, &mask, &Input::signal_mask);
+	if (not Events::init({SIGUSR1, SIGUSR2, SIGWINCH, SIGTERM})) {
+		Global::exit_error_msg = "Failed to set up event loop: " + string{strerror(errno)};
+		clean_quit(1);
+	}
 
 	if (pthread_create(&Runner::runner_id, nullptr, &Runner::_runner, nullptr) != 0) {
 		Global::exit_error_msg = "Failed to create _runner thread!";
@@ -1192,10 +1329,24 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 	if (cli.updates.has_value()) {
 		Config::set("update_ms", static_cast<int>(cli.updates.value()));
 	}
-	uint64_t update_ms = Config::getI("update_ms");
-	auto future_time = time_ms();
+	Config::Watch update_ms_setting(Config::IntKey::update_ms);
+	uint64_t update_ms = update_ms_setting.value();
+	uint64_t tick_ms = update_ms;
+	Events::arm_tick(tick_ms);
+
+	//? A dragged pane border sends a burst of SIGWINCH, the layout follows once the size has settled,
+	//? or at the latest every resize_max_ms while it keeps changing
+	constexpr uint64_t resize_settle_ms = 100, resize_max_ms = 500;
+	bool resize_pending = false;
+	uint64_t resize_since = 0;
+#ifdef AZEROTHCORE_SUPPORT
+	Events::watch(::AzerothCore::published_fd());
+#endif
 
 	try {
+		//? First collect right away, later ones on the ticks
+		Runner::run("all");
+
 		while (not true not_eq not false) {
 			//? Check for exceptions in secondary thread and exit with fail signal if true
 			if (Global::thread_exception) {
@@ -1208,81 +1359,125 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 				Global::should_sleep = false;
 				_sleep();
 			}
-			//? Hot reload config from CTRL + R or SIGUSR2
+			//? Hot reload config from CTRL + R, SIGUSR2 or an edited config file
 			else if (Global::reload_conf) {
 				Global::reload_conf = false;
-				if (Runner::active) Runner::stop();
-				Config::unlock();
-				init_config(cli.low_color, cli.filter);
-				Theme::updateThemes();
-				Theme::setTheme();
-				Draw::banner_gen(0, 0, false, true);
-				// Clear overlay and screen completely to prevent ghosting
-				Global::overlay.clear();
-				Global::overlay.shrink_to_fit();
-				cout << Term::clear << flush;
-				Global::resized = true;
+				reload_config(cli.low_color);
 			}
 
-			//? Make sure terminal size hasn't changed (in case of SIGWINCH not working properly)
-			term_resize(Global::resized);
-
-		//? Trigger secondary thread to redraw if terminal has been resized
-		if (Global::resized) {
-			// Auto-reload config on resize to pick up any external changes
-			Config::unlock();
-			init_config(cli.low_color, cli.filter);
-			Theme::updateThemes();
-			Theme::setTheme();
-			Draw::banner_gen(0, 0, false, true);
-			
-			// Clear screen to prevent ghosting
-			Global::overlay.clear();
-			Global::overlay.shrink_to_fit();
-			cout << Term::clear << flush;
-			
-			Draw::calcSizes();
-			Draw::update_clock(true);
-			Global::resized = false;
-			if (Menu::active) Menu::process();
-			else Runner::run("all", true, true);
-			atomic_wait_for(Runner::active, true, 1000);
-		}
+			//? Make sure terminal size hasn't changed (in case of SIGWINCH not working properly),
+			//? unless a resize is settling
+			if (Global::resized or not resize_pending) term_resize(Global::resized);
 
-			//? Update clock if needed
-			if (Draw::update_clock() and not Menu::active) {
-				Runner::run("clock");
+			//? Trigger secondary thread to redraw if terminal has been resized. Only the layout changes,
+			//? config and theme are kept, a changed config file is picked up by the reload above.
+			if (Global::resized) {
+				Global::overlay.clear();
+				cout << Term::clear << flush;
+				Draw::calcSizes();
+				Draw::update_clock(true);
+				Global::resized = false;
+				if (Menu::active) Menu::process();
+				else Runner::run("all", true, true);
+				atomic_wait_for(Runner::active, true, 1000);
 			}
 
-			//? Start secondary collect & draw thread at the interval set by <update_ms> config value
-			if (time_ms() >= future_time and not Global::resized) {
-				Runner::run("all");
-				update_ms = Config::getI("update_ms");
-				future_time = time_ms() + update_ms;
+			//? Ticks follow <update_ms>, or the slower eco interval, re-aligned to the wall clock whenever it changes
+			uint64_t eco_ms = 0;
+		#ifdef AZEROTHCORE_SUPPORT
+			const bool eco_changed = ::AzerothCore::eco_update();
+			eco_ms = ::AzerothCore::eco_interval();
+		#endif
+			if (update_ms_setting.changed()) update_ms = update_ms_setting.value();
+			if (const uint64_t period = std::max(update_ms, eco_ms); period != tick_ms) {
+				tick_ms = period;
+				Events::arm_tick(tick_ms);
+			}
+			//? Nobody sees the clock in eco mode, it catches up on the next tick
+			Events::arm_clock(eco_ms == 0 and Cpu::shown and not Config::getS(Config::StringKey::clock_format).empty());
+		#ifdef AZEROTHCORE_SUPPORT
+			//? Back at full rate, collect right away instead of waiting out the eco interval
+			if (eco_changed and eco_ms == 0 and not Global::resized) Runner::run("all");
+		#endif
+
+			//? Sleep until input, a tick, a clock second, a signal or a published snapshot
+			const auto ready = Events::wait();
+
+			for (const int sig : ready.signals) {
+				switch (sig) {
+					case SIGWINCH:
+						if (not resize_pending) {
+							resize_pending = true;
+							resize_since = time_ms();
+						}
+						if (time_ms() - resize_since < resize_max_ms) Events::arm_resize(resize_settle_ms);
+						break;
+					case SIGUSR2:
+						Global::reload_conf = true;
+						break;
+					case SIGTERM:
+						clean_quit(0);
+						break;
+					default:
+						//? SIGUSR1 only wakes the loop so it checks the global flags
+						break;
+				}
+			}
+			if (ready.resize) {
+				resize_pending = false;
+				term_resize();
 			}
+			if (Global::reload_conf or Global::resized or Global::should_quit or Global::should_sleep) continue;
 
-			//? Loop over input polling and input action processing
-			for (auto current_time = time_ms(); current_time < future_time; current_time = time_ms()) {
+			//? Process any input detected, focus reports only feed eco mode
+			if (ready.input and Input::poll(0)) {
+				if (not Runner::active) Config::unlock();
 
-				//? Check for external clock changes and for changes to the update timer
-				if (std::cmp_not_equal(update_ms, Config::getI("update_ms"))) {
-					update_ms = Config::getI("update_ms");
-					future_time = time_ms() + update_ms;
+				const auto key = Input::get();
+				if (is_in(key, "focus_in", "focus_out")) {
+				#ifdef AZEROTHCORE_SUPPORT
+					::AzerothCore::eco_focus(key == "focus_in");
+				#endif
 				}
-				else if (future_time - current_time > update_ms) {
-					future_time = current_time;
+				else {
+				#ifdef AZEROTHCORE_SUPPORT
+					::AzerothCore::eco_activity();
+				#endif
+					if (Menu::active) Menu::process(key);
+					else Input::process(key);
 				}
-				//? Poll for input and process any input detected
-				else if (Input::poll(min((uint64_t)1000, future_time - current_time))) {
-					if (not Runner::active) Config::unlock();
+			}
+
+			//? Update clock if needed
+			if (ready.clock and Draw::update_clock() and not Menu::active) {
+				Runner::run("clock");
+			}
 
-					if (Menu::active) Menu::process(Input::get());
-					else Input::process(Input::get());
+		#ifdef AZEROTHCORE_SUPPORT
+			//? Draw a snapshot the collector thread just published, without collecting again
+			if (not ready.watched.empty() and ::AzerothCore::take_published()) {
+				//? The advise menu waits for its report to come with a snapshot
+				if (Menu::active) {
+					if (Menu::menuMask.test(Menu::Advise)) Menu::process();
+				}
+				else if (not Global::resized) {
+					//? Brackets from the server config changed the pane heights
+					if (Draw::AzerothCore::layout_stale()) {
+						atomic_wait(Runner::active);
+						Draw::calcSizes();
+						Runner::run("all", true, true);
+					}
+					else Runner::run("all", true);
 				}
+			}
+		#endif
 
-				//? Break the loop at 1000ms intervals or if input polling was interrupted
-				else break;
+			//? An edited config file is picked up on the next pass of the loop
+			if (ready.tick and Config::modified(Config::conf_file)) Global::reload_conf = true;
 
+			//? Start secondary collect & draw thread on every tick of <update_ms>
+			if (ready.tick and not Global::resized) {
+				Runner::run("all");
 			}
 
 		}
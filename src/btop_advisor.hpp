@@ -0,0 +1,432 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "btop_mysql_rows.hpp"
+
+//* Query advisor: runs EXPLAIN FORMAT=JSON for each query of the collection set against the live schema,
+//* reports full scans, filesorts, temporary tables and row estimates, and suggests covering indexes
+//* ranked by the measured cost of the queries they would serve.
+//* Everything goes through an Exec callback returning `mysql -sN` output, so it runs the same
+//* over SSH, against local Docker or against a plain local MySQL fixture.
+namespace Advisor {
+
+	//* A collection query and the columns it touches, in the order a covering index should list them
+	struct QuerySpec {
+		std::string name;
+		std::string sql;
+		std::string table;                  // "characters", or "schema.table" outside the default database
+		std::vector<std::string> equality;  // Columns compared with constants
+		std::vector<std::string> grouping;  // GROUP BY / range columns, after the equality columns
+		std::vector<std::string> covering;  // Remaining columns read, to avoid row lookups
+	};
+
+	struct TablePlan {
+		std::string table;
+		std::string access_type;  // ALL, index, range, ref, eq_ref, const, ...
+		std::string key;          // Index used, empty for none
+		std::vector<std::string> possible_keys;
+		long long rows = 0;       // rows_examined_per_scan
+		double filtered = 100.0;
+		bool using_index = false; // Covering index, no row lookups
+		bool derived = false;     // Materialized subquery, scanning it is expected
+	};
+
+	struct Plan {
+		std::vector<TablePlan> tables;
+		double query_cost = 0.0;
+		bool filesort = false;
+		bool temporary = false;
+		bool valid = false;
+
+		long long rows() const {
+			long long total = 0;
+			for (const auto& t : tables) if (not t.derived) total += t.rows;
+			return total;
+		}
+	};
+
+	//* `mysql -sN` escapes newlines, tabs and backslashes in values, undo that
+	inline std::string unescape_batch(std::string_view text) {
+		std::string out;
+		out.reserve(text.size());
+		for (size_t i = 0; i < text.size(); i++) {
+			if (text[i] == '\\' and i + 1 < text.size()) {
+				char next = text[++i];
+				switch (next) {
+					case 'n': out += '\n'; break;
+					case 't': out += '\t'; break;
+					case '0': out += '\0'; break;
+					default: out += next; break;
+				}
+			}
+			else out += text[i];
+		}
+		return out;
+	}
+
+	namespace detail {
+		//* Single pass scanner over EXPLAIN JSON, only the keys the advisor needs are kept.
+		//* Every object under a "table" key becomes a TablePlan, nested tables of derived queries included.
+		class ExplainScanner {
+		public:
+			explicit ExplainScanner(std::string_view json) : s_(json) {}
+
+			Plan scan() {
+				skip_ws();
+				plan_.valid = value({}, 0) and (skip_ws(), pos_ == s_.size());
+				return plan_;
+			}
+
+		private:
+			static constexpr int MAX_DEPTH = 64;
+
+			void skip_ws() {
+				while (pos_ < s_.size() and (s_[pos_] == ' ' or s_[pos_] == '\n' or s_[pos_] == '\r' or s_[pos_] == '\t')) pos_++;
+			}
+
+			bool string(std::string& out) {
+				if (pos_ >= s_.size() or s_[pos_] != '"') return false;
+				pos_++;
+				out.clear();
+				while (pos_ < s_.size() and s_[pos_] != '"') {
+					if (s_[pos_] == '\\') {
+						if (++pos_ >= s_.size()) return false;
+						char c = s_[pos_];
+						if (c == 'u') pos_ += 4;  //? Non-ASCII escapes never appear in the keys or values we keep
+						else out += (c == 'n' ? '\n' : c == 't' ? '\t' : c);
+						pos_++;
+						continue;
+					}
+					out += s_[pos_++];
+				}
+				if (pos_ >= s_.size()) return false;
+				pos_++;
+				return true;
+			}
+
+			bool value(std::string_view key, int depth) {
+				if (depth > MAX_DEPTH or pos_ >= s_.size()) return false;
+				char c = s_[pos_];
+				if (c == '{') return object(key, depth);
+				if (c == '[') return array(key, depth);
+				if (c == '"') {
+					std::string text;
+					if (not string(text)) return false;
+					scalar(key, text, true);
+					return true;
+				}
+				size_t start = pos_;
+				while (pos_ < s_.size() and s_[pos_] != ',' and s_[pos_] != '}' and s_[pos_] != ']'
+					and s_[pos_] != ' ' and s_[pos_] != '\n' and s_[pos_] != '\r' and s_[pos_] != '\t') pos_++;
+				if (pos_ == start) return false;
+				scalar(key, s_.substr(start, pos_ - start), false);
+				return true;
+			}
+
+			bool object(std::string_view key, int depth) {
+				pos_++;
+				const bool is_table = (key == "table");
+				if (is_table) {
+					open_.push_back(plan_.tables.size());
+					plan_.tables.emplace_back();
+				}
+				skip_ws();
+				bool ok = true;
+				if (pos_ < s_.size() and s_[pos_] == '}') pos_++;
+				else {
+					while (true) {
+						skip_ws();
+						std::string member;
+						if (not string(member)) { ok = false; break; }
+						skip_ws();
+						if (pos_ >= s_.size() or s_[pos_] != ':') { ok = false; break; }
+						pos_++;
+						skip_ws();
+						if (member == "materialized_from_subquery" and not open_.empty()) plan_.tables[open_.back()].derived = true;
+						if (not value(member, depth + 1)) { ok = false; break; }
+						skip_ws();
+						if (pos_ < s_.size() and s_[pos_] == ',') { pos_++; continue; }
+						if (pos_ < s_.size() and s_[pos_] == '}') { pos_++; break; }
+						ok = false;
+						break;
+					}
+				}
+				if (is_table) open_.pop_back();
+				return ok;
+			}
+
+			bool array(std::string_view key, int depth) {
+				pos_++;
+				skip_ws();
+				if (pos_ < s_.size() and s_[pos_] == ']') { pos_++; return true; }
+				while (true) {
+					skip_ws();
+					if (not value(key, depth + 1)) return false;
+					skip_ws();
+					if (pos_ < s_.size() and s_[pos_] == ',') { pos_++; continue; }
+					if (pos_ < s_.size() and s_[pos_] == ']') { pos_++; return true; }
+					return false;
+				}
+			}
+
+			void scalar(std::string_view key, std::string_view text, bool quoted) {
+				if (key == "query_cost" and plan_.query_cost == 0.0) plan_.query_cost = to_double(text);
+				else if (key == "using_filesort" and text == "true") plan_.filesort = true;
+				else if (key == "using_temporary_table" and text == "true") plan_.temporary = true;
+				if (open_.empty()) return;
+
+				auto& t = plan_.tables[open_.back()];
+				if (key == "table_name") {
+					t.table = std::string(text);
+					if (t.table.starts_with("<derived")) t.derived = true;
+				}
+				else if (key == "access_type") t.access_type = std::string(text);
+				else if (key == "key") t.key = std::string(text);
+				else if (key == "possible_keys" and quoted) t.possible_keys.emplace_back(text);
+				else if (key == "rows_examined_per_scan") t.rows = static_cast<long long>(to_double(text));
+				else if (key == "filtered") t.filtered = to_double(text);
+				else if (key == "using_index") t.using_index = (text == "true");
+			}
+
+			static double to_double(std::string_view text) {
+				double value = 0.0;
+				std::from_chars(text.data(), text.data() + text.size(), value);
+				return value;
+			}
+
+			std::string_view s_;
+			size_t pos_ = 0;
+			Plan plan_;
+			std::vector<size_t> open_;  // Indices of the table objects being read
+		};
+	}
+
+	//* Parse EXPLAIN FORMAT=JSON output, plan.valid is false for malformed input
+	inline Plan parse_explain(std::string_view json) {
+		return detail::ExplainScanner(json).scan();
+	}
+
+	struct Index {
+		std::string name;
+		std::vector<std::string> columns;
+	};
+
+	//* Existing indexes per table from information_schema.STATISTICS rows:
+	//* is_default_schema, schema, table, index, seq_in_index, column
+	inline std::map<std::string, std::vector<Index>> parse_indexes(std::string_view result) {
+		std::map<std::string, std::vector<Index>> indexes;
+		for (const auto& row : Mysql::rows<int, std::string_view, std::string_view, std::string_view, int, std::string_view>(result)) {
+			if (not row) continue;
+			auto [is_default, schema, table, index, seq, column] = *row;
+			std::string key = is_default ? std::string(table) : std::string(schema) + "." + std::string(table);
+			auto& list = indexes[key];
+			if (list.empty() or list.back().name != index) list.push_back({std::string(index), {}});
+			list.back().columns.emplace_back(column);
+		}
+		return indexes;
+	}
+
+	//* Index columns for a query: equality columns, then grouping, then the rest for coverage
+	inline std::vector<std::string> covering_columns(const QuerySpec& spec) {
+		std::vector<std::string> columns;
+		for (const auto* part : {&spec.equality, &spec.grouping, &spec.covering}) {
+			for (const auto& c : *part) {
+				if (std::find(columns.begin(), columns.end(), c) == columns.end()) columns.push_back(c);
+			}
+		}
+		return columns;
+	}
+
+	//* Whether an existing index already serves the query as well as the suggestion would:
+	//* equality and grouping columns as its leading columns, all other columns somewhere in it
+	inline bool index_serves(const Index& index, const QuerySpec& spec) {
+		size_t lead = 0;
+		for (const auto* part : {&spec.equality, &spec.grouping}) {
+			for (const auto& c : *part) {
+				if (lead >= index.columns.size() or index.columns[lead] != c) return false;
+				lead++;
+			}
+		}
+		for (const auto& c : spec.covering) {
+			if (std::find(index.columns.begin(), index.columns.end(), c) == index.columns.end()) return false;
+		}
+		return true;
+	}
+
+	struct QueryReport {
+		std::string name;
+		Plan plan;
+		double cost_ms = 0.0;  // Best of the timed runs
+		std::vector<std::string> problems;
+	};
+
+	struct Suggestion {
+		std::string table;
+		std::vector<std::string> columns;
+		double cost_ms = 0.0;  // Measured cost of the queries it would serve
+		std::vector<std::string> queries;
+
+		std::string ddl() const {
+			std::string name = "idx_bottop";
+			std::string list;
+			for (const auto& c : columns) {
+				name += "_" + c;
+				list += (list.empty() ? "" : ", ") + c;
+			}
+			return "CREATE INDEX " + name + " ON " + table + " (" + list + ");";
+		}
+	};
+
+	struct Report {
+		std::vector<QueryReport> queries;
+		std::vector<Suggestion> suggestions;
+		std::string error;
+
+		//* Text report, wide adds the index used per query
+		std::vector<std::string> lines(bool wide = true) const {
+			std::vector<std::string> out;
+			if (not error.empty()) {
+				out.push_back("Error: " + error);
+				return out;
+			}
+			char buf[256];
+			std::snprintf(buf, sizeof(buf), "%-15s %8s %9s %-7s %s", "Query", "Cost", "Rows", "Access", wide ? "Key / Problems" : "Problems");
+			out.emplace_back(buf);
+			for (const auto& q : queries) {
+				std::string access, key, problems;
+				for (const auto& t : q.plan.tables) {
+					if (t.derived) continue;
+					access = t.access_type;
+					key = t.key.empty() ? "-" : t.key;
+				}
+				for (const auto& p : q.problems) problems += (problems.empty() ? "" : ", ") + p;
+				if (problems.empty()) problems = "ok";
+				std::snprintf(buf, sizeof(buf), "%-15.15s %6.1fms %9lld %-7.7s %s", q.name.c_str(), q.cost_ms, q.plan.rows(), access.c_str(),
+					(wide ? key + " / " + problems : problems).c_str());
+				out.emplace_back(buf);
+			}
+			out.emplace_back("");
+			if (suggestions.empty()) {
+				out.emplace_back("No missing indexes, every query is served by an existing index.");
+				return out;
+			}
+			out.emplace_back("Suggested indexes, by measured cost:");
+			for (size_t i = 0; i < suggestions.size(); i++) {
+				const auto& s = suggestions[i];
+				std::string served;
+				for (const auto& q : s.queries) served += (served.empty() ? "" : ", ") + q;
+				std::snprintf(buf, sizeof(buf), "%zu. %.1fms  %s", i + 1, s.cost_ms, served.c_str());
+				out.emplace_back(buf);
+				out.push_back("   " + s.ddl());
+			}
+			return out;
+		}
+	};
+
+	//* Runs sql and returns `mysql -sN` output, empty on failure
+	using Exec = std::function<std::string(const std::string& sql)>;
+
+	//* Problems the plan shows for a query
+	inline std::vector<std::string> find_problems(const Plan& plan) {
+		std::vector<std::string> problems;
+		for (const auto& t : plan.tables) {
+			if (t.derived) continue;
+			if (t.access_type == "ALL") problems.push_back("full scan of " + t.table);
+			else if (t.access_type == "index") problems.push_back("full index scan of " + t.table);
+			else if (not t.using_index and not t.key.empty()) problems.push_back("row lookups");
+		}
+		if (plan.temporary) problems.emplace_back("temporary table");
+		if (plan.filesort) problems.emplace_back("filesort");
+		return problems;
+	}
+
+	inline Report run(const std::vector<QuerySpec>& specs, const Exec& exec, int timed_runs = 3) {
+		Report report;
+
+		//? Existing indexes of every table the collection set reads
+		std::string tables;
+		for (const auto& spec : specs) {
+			auto dot = spec.table.find('.');
+			std::string cond = (dot == std::string::npos)
+				? "(TABLE_SCHEMA = DATABASE() AND TABLE_NAME = '" + spec.table + "')"
+				: "(TABLE_SCHEMA = '" + spec.table.substr(0, dot) + "' AND TABLE_NAME = '" + spec.table.substr(dot + 1) + "')";
+			if (tables.find(cond) == std::string::npos) tables += (tables.empty() ? "" : " OR ") + cond;
+		}
+		auto indexes = parse_indexes(exec(
+			"SELECT TABLE_SCHEMA = DATABASE(), TABLE_SCHEMA, TABLE_NAME, INDEX_NAME, SEQ_IN_INDEX, COLUMN_NAME "
+			"FROM information_schema.STATISTICS WHERE " + tables + " "
+			"ORDER BY TABLE_SCHEMA, TABLE_NAME, INDEX_NAME, SEQ_IN_INDEX;"));
+		if (indexes.empty()) {
+			report.error = "Could not read indexes from information_schema, check the database connection";
+			return report;
+		}
+
+		for (const auto& spec : specs) {
+			QueryReport q;
+			q.name = spec.name;
+			q.plan = parse_explain(unescape_batch(exec("EXPLAIN FORMAT=JSON " + spec.sql)));
+			if (not q.plan.valid) {
+				q.problems.emplace_back("EXPLAIN failed");
+				report.queries.push_back(std::move(q));
+				continue;
+			}
+			q.problems = find_problems(q.plan);
+
+			for (int i = 0; i < timed_runs; i++) {
+				auto start = std::chrono::steady_clock::now();
+				exec(spec.sql);
+				double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+				if (i == 0 or ms < q.cost_ms) q.cost_ms = ms;
+			}
+
+			//? Suggest a covering index when the plan has problems and no existing index would do better
+			const auto& existing = indexes[spec.table];
+			bool served = std::any_of(existing.begin(), existing.end(), [&](const Index& idx) { return index_serves(idx, spec); });
+			if (not q.problems.empty() and not served) {
+				auto columns = covering_columns(spec);
+				auto it = std::find_if(report.suggestions.begin(), report.suggestions.end(),
+					[&](const Suggestion& s) { return s.table == spec.table and s.columns == columns; });
+				if (it == report.suggestions.end()) {
+					report.suggestions.push_back({spec.table, columns, 0.0, {}});
+					it = std::prev(report.suggestions.end());
+				}
+				it->cost_ms += q.cost_ms;
+				it->queries.push_back(spec.name);
+			}
+			report.queries.push_back(std::move(q));
+		}
+
+		std::stable_sort(report.suggestions.begin(), report.suggestions.end(),
+			[](const Suggestion& a, const Suggestion& b) { return a.cost_ms > b.cost_ms; });
+		return report;
+	}
+
+}
@@ -18,12 +18,19 @@ tab-size = 4
 
 #include "btop_azerothcore.hpp"
 #include "btop_tools.hpp"
+#include "btop_mysql_rows.hpp"
+#include "btop_serverinfo.hpp"
 #include <libssh2.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netdb.h>
 #include <unistd.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <sys/eventfd.h>
 #include <signal.h>
+#include <charconv>
 #include <cstring>
 #include <cerrno>
 #include <sstream>
@@ -32,11 +39,13 @@ tab-size = 4
 #include <chrono>
 #include <sys/stat.h>
 #include <map>
+#include <array>
 #include <pwd.h>
 #include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <filesystem>
 #include <fstream>
-#include <fstream>
-#include <regex>
 #include <iostream>
 
 using namespace Tools;
@@ -49,15 +58,71 @@ namespace AzerothCore {
 	ServerConfig config;
 	std::unique_ptr<CommandExecutor> executor;  // Can be SSHClient or LocalExecutor
 	std::unique_ptr<Query> query;
-	ServerData current_data;
+	ServerData current_data;  // Working copy of the collector thread, everyone else reads published snapshots
 	ExpectedValues expected_values;
+	LoadBudget load_budget;
+	QueryCache query_cache;
+	BotList bot_list;
+	
+	//* Realms
+	std::vector<RealmConfig> realm_configs;  // parse_realms(config), collector thread only, the UI reads snapshot()->realms
+	size_t primary_realm = 0;                // Index of the realm in the main view
+	std::atomic<int> requested_realm{-1};    // Set by switch_realm, taken by the collector
+	
+	//* Settings from a config reload, set by reconfigure and taken by the collector under collector_mutex
+	std::optional<ServerConfig> pending_config;
+	bool pending_reconnect = false;
+	uint64_t advice_requested = 0;  // Last request_advice(), answered once current_data.advice_request reaches it
+	RealmWatch realm_watch;
+	
+	//* Name search
+	std::mutex name_index_mutex;
+	std::shared_ptr<const Names::Index> current_name_index = std::make_shared<const Names::Index>();
+	const size_t NAME_BATCH = 500;  // guids per name lookup, more newcomers than this read all online names at once
+	
+	//* Table size monitoring
+	TableGrowth table_growth;
+	const uint64_t TABLES_INTERVAL_MS = 600000;  // information_schema.TABLES is read this rarely
+	const uint64_t TABLES_RETRY_MS = 60000;      // After a shed or failed read
+	uint64_t next_tables_time = 0;
+	
+	//* Collector thread and the snapshots it publishes
+	std::atomic<std::shared_ptr<const ServerData>> published{std::make_shared<const ServerData>()};
+	std::atomic<bool> fresh{false};  // A snapshot was published and not drawn yet
+	int publish_event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);  // Signals the main loop a snapshot was published
+	std::thread collector;
+	std::mutex collector_mutex;
+	std::condition_variable collector_cv;
+	bool collect_requested = false;
+	bool collector_stopping = false;
+	void publish();
 	
 	//* Historical data for graphs
 	std::deque<long long> load_history;
+	std::deque<long long> lock_wait_history;
+	std::deque<long long> statement_ms_history;
+	std::deque<bool> eco_history;
+	
+	//* Eco mode, the state behind eco_interval() belongs to the main thread
+	std::atomic<uint64_t> eco_interval_ms{0};
+	std::atomic<int> eco_idle_s{0};     // Settings of the config, set by init and reconfigure
+	std::atomic<int> eco_ms{0};
+	bool term_focused = true;           // Until a focus report says otherwise, terminals without them stay focused
+	uint64_t last_activity_ms = 0;
+	bool window_hidden = false;         // tmux window or session not shown, screen session detached
+	uint64_t next_window_check_ms = 0;
+	const uint64_t WINDOW_CHECK_MS = 15000;  // tmux and screen are asked this often
 	
-	//* Cached performance data (last known good values)
-	::AzerothCore::ServerPerformance last_known_perf;
-	uint64_t last_perf_update_time = 0;
+	//* Persistent mysql client
+	constexpr std::string_view SESSION_END_MARKER = "__bottop_session_end__";  // Selected after each request
+	const uint64_t SESSION_TIMEOUT_MS = 5000;
+	
+	//* Lock monitor
+	const int LOCK_TRANSACTIONS = 5;   // Longest running transactions listed
+	const size_t LOCK_DIGESTS = 10;    // Statement digests listed
+	const int DIGEST_BASELINE_S = 600; // The first read only records totals of digests seen this recently
+	
+	//* "server info" is read at most this often, Query keeps the last good values in between
 	const uint64_t PERF_UPDATE_INTERVAL_MS = 5000;  // Update every 5 seconds
 	
 	//* Track previous server status for disconnection detection
@@ -66,29 +131,290 @@ namespace AzerothCore {
 	//* Config refresh tracking
 	uint64_t last_config_refresh_time = 0;
 	const uint64_t CONFIG_REFRESH_INTERVAL_MS = 90000;  // Refresh config every 90 seconds
+	
+	//* Discovery of the container, worldserver.conf and excluded accounts, cached across runs
+	struct Discovery {
+		std::string container;
+		std::string config_path;
+		std::string fingerprint;   // mtime:size of worldserver.conf and the bracket config, mtime in nanoseconds
+		std::string excluded;      // Excluded account ids, comma separated
+		std::string world_conf;    // AiPlayerbot.*RandomBots lines of worldserver.conf
+		std::string bracket_conf;  // mod_player_bot_level_brackets.conf
+		bool unchanged = false;    // Fingerprint matched, the two files were not sent
+	};
+	Discovery last_discovery;
+	bool container_discovered = false;    // config.container came from discovery, not the user
+	bool config_path_discovered = false;
+	bool discovery_unverified = false;    // Loaded from the cache and not confirmed by the server yet
+	uint64_t next_accounts_time = 0;      // Excluded accounts are read again after ACCOUNTS_TTL_MS
+	const char* WORLDSERVER_CONF_PATHS = "/azerothcore/env/dist/etc/worldserver.conf /etc/worldserver.conf "
+		"/opt/azerothcore/etc/worldserver.conf /azerothcore/etc/worldserver.conf";
+	const char* BRACKET_CONF_PATH = "/azerothcore/env/dist/etc/modules/mod_player_bot_level_brackets.conf";
+	static bool load_cached_discovery();
+	
+	//* Adaptive timeouts and hedging
+	const uint64_t DEFAULT_TIMEOUT_MS = 10000;  // Used until a query type has enough samples
+	const uint64_t MIN_TIMEOUT_MS = 2000;
+	const uint64_t MAX_TIMEOUT_MS = 10000;
+	const int MAX_HEDGES_IN_FLIGHT = 2;         // Across all executors
+	std::atomic<int> hedges_in_flight{0};
+	
+	//* Cancellation
+	const uint64_t CONNECT_TIMEOUT_MS = 10000;  // TCP connect, SSH handshake and authentication together
+	const uint64_t CYCLE_DEADLINE_MS = 20000;   // A collection cycle still running after this is abandoned
+	const std::chrono::milliseconds CANCEL_CLOSE_MS{100};  // Clean channel close after a cancel, then it is freed
+	Cancel cycle_cancel;  // Of the collector's current cycle, also used by init() when it runs there
+	std::stop_source cycle_stop;  // Behind cycle_cancel, replaced once used. Guarded by collector_mutex
+	
+	//* Round-trip budget tracking
+	const uint64_t BUDGET_WINDOW_MS = 60000;  // Budget is expressed per minute
+	uint64_t next_full_cycle_time = 0;        // Earliest time the next full collection may run
+	
+	//* Sampled distributions
+	const uint64_t SAMPLE_RECONCILE_MS = 300000;  // Exact counts at least this often when sampling
+	const double SAMPLE_Z = 1.96;                 // 95% confidence
+	uint64_t next_exact_cycle_time = 0;
+	
+	//* Query cache TTLs
+	const uint64_t COLLECTION_TTL_MS = 1000;    // Distribution queries, shares them within one cycle
+	const uint64_t CONTAINERS_TTL_MS = 2000;    // docker ps status listing
+	const uint64_t DISCOVERY_TTL_MS = 30000;    // Config file reads and container/path discovery
+	const uint64_t ACCOUNTS_TTL_MS = 600000;    // Excluded account ids rarely change
+
+	//* Server-maintained summary table
+	const char* SUMMARY_TABLE = "bottop_online_summary";
+	const int SUMMARY_REFRESH_S = 5;              // Event schedule
+	const int SUMMARY_STALE_S = 30;               // Older than this the event is not running, read characters
+	const uint64_t SUMMARY_CHECK_MS = 300000;     // Look for a newly installed or dropped summary
+	const uint64_t SUMMARY_VERIFY_MS = 60000;     // Exact count to check the summary against
+
+	//* Accounts whose characters are real players, not bots
+	const char* EXCLUDED_USERNAMES = "'HAVOC','JOSHG','JOSHR','JON','CAITR','COLTON','KELSEYG','KYLAN','SETH','AHBOT'";
+
+	uint64_t query_kind(const std::string& command) {
+		// FNV-1a over the command text, with each run of digits folded into a single '#'
+		uint64_t hash = 14695981039346656037ull;
+		bool in_number = false;
+		for (char c : command) {
+			bool digit = (c >= '0' && c <= '9');
+			if (digit && in_number) continue;
+			in_number = digit;
+			hash ^= (uint8_t)(digit ? '#' : c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	//* LatencyTracker implementation
+	void LatencyTracker::record(uint64_t kind, uint64_t ms) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto& ring = rings_[kind];
+		ring.samples[ring.next] = (uint32_t)std::min<uint64_t>(ms, UINT32_MAX);
+		ring.next = (ring.next + 1) % WINDOW;
+		ring.count = std::min(ring.count + 1, WINDOW);
+	}
 
+	uint64_t LatencyTracker::quantile(uint64_t kind, double q) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = rings_.find(kind);
+		if (it == rings_.end() || it->second.count < MIN_SAMPLES) return 0;
+		
+		std::array<uint32_t, WINDOW> sorted = it->second.samples;
+		size_t n = it->second.count;
+		size_t rank = std::min(n - 1, (size_t)(q * n));
+		std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + n);
+		return sorted[rank];
+	}
+
+	uint64_t LatencyTracker::timeout_ms(uint64_t kind) {
+		uint64_t p99 = quantile(kind, 0.99);
+		if (p99 == 0) return DEFAULT_TIMEOUT_MS;
+		return std::clamp<uint64_t>(p99 * 4, MIN_TIMEOUT_MS, MAX_TIMEOUT_MS);
+	}
+
+	namespace {
+		//* In a forked child before exec: the signal mask and dispositions a new process starts with. Otherwise the
+		//* shell inherits the forking thread's mask, collector threads block every signal, and ignores SIGTERM.
+		void reset_child_signals() {
+			sigset_t none;
+			sigemptyset(&none);
+			sigprocmask(SIG_SETMASK, &none, nullptr);
+			for (int sig = 1; sig < NSIG; sig++) signal(sig, SIG_DFL);
+		}
+		
+		//* SIGTERM the child pid, or its process group when group, and reap it. Whatever is still there
+		//* after grace gets SIGKILL, so this never waits on the command itself.
+		void end_child(pid_t pid, bool group, std::chrono::milliseconds grace) {
+			const pid_t target = group ? -pid : pid;
+			kill(target, SIGTERM);
+			const auto deadline = std::chrono::steady_clock::now() + grace;
+			while (true) {
+				const pid_t rc = waitpid(pid, nullptr, WNOHANG);
+				if (rc == pid || (rc < 0 && errno != EINTR)) return;
+				if (std::chrono::steady_clock::now() >= deadline) break;
+				usleep(5000);
+			}
+			kill(target, SIGKILL);
+			while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {}
+		}
+	}
+	
 	//* LocalExecutor implementation
-	std::string LocalExecutor::execute(const std::string& command) {
+	std::string LocalExecutor::execute(const std::string& command, const Cancel& cancel) {
 		Logger::error("LOCAL EXEC: " + command);
+		requests_++;
+		auto start_ms = time_ms();
 		
-		FILE* pipe = popen(command.c_str(), "r");
-		if (!pipe) {
+		// Not popen(): a read blocked in fgets could not be abandoned when the work is cancelled
+		int fds[2];
+		if (pipe2(fds, O_CLOEXEC) != 0) {
+			error_ = "Failed to execute command locally";
+			return "";
+		}
+		const char* shell_command = command.c_str();
+		pid_t pid = fork();
+		if (pid == 0) {
+			setpgid(0, 0);  // Own process group, so a cancel also reaches what the shell started
+			reset_child_signals();
+			dup2(fds[1], STDOUT_FILENO);
+			execl("/bin/sh", "sh", "-c", shell_command, nullptr);
+			_exit(127);
+		}
+		close(fds[1]);
+		if (pid < 0) {
+			close(fds[0]);
 			error_ = "Failed to execute command locally";
 			return "";
 		}
+		setpgid(pid, pid);
 		
-		std::ostringstream output;
+		std::string output;
 		char buffer[4096];
-		while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-			output << buffer;
+		bool cancelled = false;
+		while (true) {
+			if (cancel.expired()) {
+				cancelled = true;
+				break;
+			}
+			pollfd pfd{fds[0], POLLIN, 0};
+			int rc = poll(&pfd, 1, (int)cancel.left(Cancel::CHECK_MS).count());
+			if (rc == 0 || (rc < 0 && errno == EINTR)) continue;
+			if (rc < 0) break;
+			ssize_t n = read(fds[0], buffer, sizeof(buffer));
+			if (n < 0 && errno == EINTR) continue;
+			if (n <= 0) break;
+			output.append(buffer, n);
+		}
+		close(fds[0]);
+		
+		if (cancelled) {
+			end_child(pid, true, CANCEL_CLOSE_MS);
+			error_ = "Cancelled";
+			return "";
 		}
-		
-		int status = pclose(pipe);
-		if (status != 0 && status != -1) {
+		int status = 0;
+		while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+		if (status != 0) {
 			error_ = "Command exited with status " + std::to_string(status);
 		}
 		
-		return output.str();
+		latency_.record(query_kind(command), time_ms() - start_ms);
+		return output;
+	}
+
+	namespace {
+		//* Offset of the line end_marker in output, npos while it has not arrived
+		size_t marker_line(const std::string& output, std::string_view end_marker) {
+			if (output.starts_with(end_marker) && output.size() > end_marker.size() && output[end_marker.size()] == '\n') return 0;
+			const std::string line = "\n" + std::string(end_marker) + "\n";
+			const size_t pos = output.find(line);
+			return pos == std::string::npos ? pos : pos + 1;
+		}
+		
+		//* Child process with one end of a socketpair as stdin and stdout. send() with MSG_NOSIGNAL,
+		//* so a child that exited never raises SIGPIPE in bottop.
+		class LocalSession : public Session {
+		public:
+			explicit LocalSession(const std::string& command) {
+				int fds[2];
+				if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) return;
+				const char* shell_command = command.c_str();
+				pid_ = fork();
+				if (pid_ == 0) {
+					setpgid(0, 0);
+					reset_child_signals();
+					dup2(fds[1], STDIN_FILENO);
+					dup2(fds[1], STDOUT_FILENO);
+					execl("/bin/sh", "sh", "-c", shell_command, nullptr);
+					_exit(127);
+				}
+				close(fds[1]);
+				if (pid_ < 0) {
+					close(fds[0]);
+					return;
+				}
+				setpgid(pid_, pid_);
+				fd_ = fds[0];
+			}
+			
+			~LocalSession() override { stop(); }
+			
+			std::string exchange(const std::string& input, std::string_view end_marker, std::chrono::milliseconds timeout,
+								 const Cancel& cancel) override {
+				if (fd_ < 0) return "";
+				const auto deadline = std::min(std::chrono::steady_clock::now() + timeout, cancel.deadline);
+				
+				for (size_t sent = 0; sent < input.size();) {
+					ssize_t n = send(fd_, input.data() + sent, input.size() - sent, MSG_NOSIGNAL);
+					if (n < 0 && errno == EINTR) continue;
+					if (n <= 0) return stop();
+					sent += n;
+				}
+				
+				std::string output;
+				char buffer[4096];
+				while (true) {
+					if (size_t end = marker_line(output, end_marker); end != std::string::npos) {
+						output.resize(end);
+						return output;
+					}
+					auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+					if (left.count() <= 0 || cancel.stop.stop_requested()) return stop();
+					pollfd pfd{fd_, POLLIN, 0};
+					int rc = poll(&pfd, 1, (int)std::min(left, Cancel::CHECK_MS).count());
+					if (rc == 0 || (rc < 0 && errno == EINTR)) continue;
+					if (rc < 0) return stop();
+					ssize_t n = read(fd_, buffer, sizeof(buffer));
+					if (n < 0 && errno == EINTR) continue;
+					if (n <= 0) return stop();
+					output.append(buffer, n);
+				}
+			}
+			
+			bool alive() const override { return fd_ >= 0; }
+			
+		private:
+			int fd_ = -1;
+			pid_t pid_ = -1;
+			
+			//* Closing stdin ends the client, the signals cover one stuck on a query
+			std::string stop() {
+				if (fd_ >= 0) close(fd_);
+				fd_ = -1;
+				if (pid_ > 0) end_child(pid_, true, CANCEL_CLOSE_MS);
+				pid_ = -1;
+				return "";
+			}
+		};
+	}
+	
+	std::unique_ptr<Session> LocalExecutor::open_session(const std::string& command, [[maybe_unused]] const Cancel& cancel) {
+		auto session = std::make_unique<LocalSession>(command);
+		if (!session->alive()) {
+			error_ = "Failed to start command locally";
+			return nullptr;
+		}
+		return session;
 	}
 
 	//* SSHClient implementation
@@ -108,7 +434,7 @@ namespace AzerothCore {
 		libssh2_exit();
 	}
 
-	bool SSHClient::connect() {
+	bool SSHClient::connect(const Cancel& cancel) {
 		// Parse host (format: user@hostname:port or user@hostname)
 		std::string user, hostname;
 		int port = 22;
@@ -162,9 +488,29 @@ namespace AzerothCore {
 		sin.sin_addr = *reinterpret_cast<struct in_addr*>(host_info->h_addr);
 		
 		Logger::error("SSHClient::connect() attempting socket connect...");
+		// Non-blocking from here on, every step below gives up when cancelled or past CONNECT_TIMEOUT_MS
+		const auto connect_deadline = std::min(cancel.deadline, Cancel::Clock::now() + std::chrono::milliseconds(CONNECT_TIMEOUT_MS));
+		const Cancel connecting{cancel.stop, connect_deadline};
+		fcntl(sock_, F_SETFL, fcntl(sock_, F_GETFL) | O_NONBLOCK);
+		int connect_errno = 0;
 		if (::connect(sock_, reinterpret_cast<struct sockaddr*>(&sin), sizeof(sin)) != 0) {
-			error_ = "Failed to connect to " + hostname + ":" + std::to_string(port) + " - " + std::string(strerror(errno));
-			Logger::error("SSHClient::connect() failed: connect() returned error, errno=" + std::to_string(errno) + " msg=" + std::string(strerror(errno)));
+			connect_errno = errno;
+			if (connect_errno == EINPROGRESS) {
+				connect_errno = ETIMEDOUT;
+				while (!connecting.expired()) {
+					pollfd pfd{sock_, POLLOUT, 0};
+					int rc = poll(&pfd, 1, (int)connecting.left(Cancel::CHECK_MS).count());
+					if (rc == 0 || (rc < 0 && errno == EINTR)) continue;
+					socklen_t len = sizeof(connect_errno);
+					if (rc < 0 || getsockopt(sock_, SOL_SOCKET, SO_ERROR, &connect_errno, &len) != 0) connect_errno = errno;
+					break;
+				}
+				if (cancel.stop.stop_requested()) connect_errno = ECANCELED;
+			}
+		}
+		if (connect_errno != 0) {
+			error_ = "Failed to connect to " + hostname + ":" + std::to_string(port) + " - " + std::string(strerror(connect_errno));
+			Logger::error("SSHClient::connect() failed: connect() returned error, errno=" + std::to_string(connect_errno) + " msg=" + std::string(strerror(connect_errno)));
 			close(sock_);
 			sock_ = -1;
 			return false;
@@ -182,9 +528,20 @@ namespace AzerothCore {
 		}
 		
 		auto* session = static_cast<LIBSSH2_SESSION*>(session_);
+		libssh2_session_set_blocking(session, 0);
+		
+		// libssh2 calls return EAGAIN until the socket has what they wait for
+		auto call = [&](auto&& step) {
+			int rc;
+			while ((rc = step()) == LIBSSH2_ERROR_EAGAIN) {
+				if (connecting.expired()) return LIBSSH2_ERROR_TIMEOUT;
+				usleep(10000);
+			}
+			return rc;
+		};
 		
 		// Start SSH handshake
-		if (libssh2_session_handshake(session, sock_) != 0) {
+		if (call([&] { return libssh2_session_handshake(session, sock_); }) != 0) {
 			char* err_msg;
 			libssh2_session_last_error(session, &err_msg, nullptr, 0);
 			error_ = std::string("SSH handshake failed: ") + err_msg;
@@ -235,13 +592,15 @@ namespace AzerothCore {
 			}
 			
 			// Try authentication with this key
-			int rc = libssh2_userauth_publickey_fromfile(
-				session, 
-				user.c_str(),
-				public_key.c_str(),
-				private_key.c_str(),
-				nullptr  // No passphrase
-			);
+			int rc = call([&] {
+				return libssh2_userauth_publickey_fromfile(
+					session,
+					user.c_str(),
+					public_key.c_str(),
+					private_key.c_str(),
+					nullptr  // No passphrase
+				);
+			});
 			
 			if (rc == 0) {
 				auth_success = true;
@@ -262,94 +621,260 @@ namespace AzerothCore {
 			return false;
 		}
 		
-		// Set non-blocking mode
-		libssh2_session_set_blocking(session, 0);
-		
 		return true;
 	}
 
-	std::string SSHClient::execute(const std::string& command) {
+	namespace {
+		//* Open a session channel and start a command on it, polling the non-blocking session
+		LIBSSH2_CHANNEL* open_exec_channel(LIBSSH2_SESSION* session, const std::string& command,
+										   std::chrono::milliseconds timeout, std::string& error, const Cancel& cancel) {
+			LIBSSH2_CHANNEL* channel = nullptr;
+			auto start_time = std::chrono::steady_clock::now();
+			
+			while ((channel = libssh2_channel_open_session(session)) == nullptr &&
+				   libssh2_session_last_error(session, nullptr, nullptr, 0) == LIBSSH2_ERROR_EAGAIN) {
+				if (cancel.expired()) {
+					error = "Cancelled";
+					return nullptr;
+				}
+				if (std::chrono::steady_clock::now() - start_time > timeout) {
+					error = "Timeout opening SSH channel";
+					return nullptr;
+				}
+				usleep(10000); // Sleep 10ms to avoid busy-waiting
+			}
+			
+			if (!channel) {
+				char* err_msg;
+				libssh2_session_last_error(session, &err_msg, nullptr, 0);
+				error = std::string("Failed to open channel: ") + err_msg;
+				return nullptr;
+			}
+			
+			start_time = std::chrono::steady_clock::now();
+			while (libssh2_channel_exec(channel, command.c_str()) == LIBSSH2_ERROR_EAGAIN) {
+				if (cancel.expired() || std::chrono::steady_clock::now() - start_time > timeout) {
+					error = cancel.expired() ? "Cancelled" : "Timeout executing command";
+					libssh2_channel_free(channel);
+					return nullptr;
+				}
+				usleep(10000);
+			}
+			
+			return channel;
+		}
+		
+		//* Take the connection's exec mutex unless cancel expires first, a command queued behind a
+		//* slow one still honours its stop and deadline. Check owns_lock() on what is returned.
+		std::unique_lock<std::timed_mutex> lock_within(std::timed_mutex& mutex, const Cancel& cancel) {
+			std::unique_lock lock(mutex, std::defer_lock);
+			while (!lock.try_lock_for(Cancel::CHECK_MS) && !cancel.expired()) {}
+			return lock;
+		}
+		
+		//* Close and free a channel, giving up on a clean close after the timeout
+		void close_channel(LIBSSH2_CHANNEL* channel, std::chrono::milliseconds timeout) {
+			auto start_time = std::chrono::steady_clock::now();
+			while (libssh2_channel_close(channel) == LIBSSH2_ERROR_EAGAIN) {
+				if (std::chrono::steady_clock::now() - start_time > timeout) break;
+				usleep(10000);
+			}
+			libssh2_channel_free(channel);
+		}
+	}
+
+	std::string SSHClient::execute(const std::string& command, const Cancel& cancel) {
 		if (!session_) {
 			error_ = "Not connected";
 			return "";
 		}
 		
+		auto lock = lock_within(exec_mutex_, cancel);
+		if (!lock.owns_lock()) return "";
 		auto* session = static_cast<LIBSSH2_SESSION*>(session_);
-		LIBSSH2_CHANNEL* channel = nullptr;
-		
-		// Open channel with timeout
-		auto start_time = std::chrono::steady_clock::now();
-		const auto timeout = std::chrono::seconds(10);
-		
-		while ((channel = libssh2_channel_open_session(session)) == nullptr &&
-			   libssh2_session_last_error(session, nullptr, nullptr, 0) == LIBSSH2_ERROR_EAGAIN) {
-			if (std::chrono::steady_clock::now() - start_time > timeout) {
-				error_ = "Timeout opening SSH channel";
-				return "";
-			}
-			usleep(10000); // Sleep 10ms to avoid busy-waiting
-		}
+		requests_++;
+		
+		// Timeout and hedge threshold come from this query type's observed latency.
+		// Only mysql reads are duplicated, console commands like "server info" are not idempotent.
+		const uint64_t kind = query_kind(command);
+		const auto timeout = std::chrono::milliseconds(latency_.timeout_ms(kind));
+		const bool hedgeable = command.find(" mysql ") != std::string::npos;
+		const auto hedge_after = std::chrono::milliseconds(hedgeable ? latency_.quantile(kind, 0.95) : 0);
+		
+		//? [0] is the original request, [1] the hedged duplicate on a second channel
+		struct Attempt {
+			LIBSSH2_CHANNEL* channel = nullptr;
+			std::string output;
+		};
+		std::array<Attempt, 2> attempts;
+		bool hedge_tried = false;
 		
-		if (!channel) {
-			char* err_msg;
-			libssh2_session_last_error(session, &err_msg, nullptr, 0);
-			error_ = std::string("Failed to open channel: ") + err_msg;
+		const auto start_time = std::chrono::steady_clock::now();
+		attempts[0].channel = open_exec_channel(session, command, timeout, error_, cancel);
+		if (!attempts[0].channel) {
+			if (error_.starts_with("Timeout")) latency_.record(kind, timeout.count());
 			return "";
 		}
 		
-		// Execute command with timeout
-		start_time = std::chrono::steady_clock::now();
-		while (libssh2_channel_exec(channel, command.c_str()) == LIBSSH2_ERROR_EAGAIN) {
-			if (std::chrono::steady_clock::now() - start_time > timeout) {
-				error_ = "Timeout executing command";
-				libssh2_channel_free(channel);
+		// Channels are always closed and freed, after a cancel without waiting long on the remote end
+		auto release = [&](Attempt& attempt, bool is_hedge) {
+			if (!attempt.channel) return;
+			close_channel(attempt.channel, cancel.expired() ? CANCEL_CLOSE_MS : timeout);
+			attempt.channel = nullptr;
+			if (is_hedge) hedges_in_flight--;
+		};
+		
+		// Read output from whichever attempt is live, first one to reach EOF wins
+		int winner = -1;
+		char buffer[4096];
+		auto last_data = start_time;
+		
+		while (winner < 0) {
+			for (int i = 0; i < 2 && winner < 0; i++) {
+				auto& attempt = attempts[i];
+				if (!attempt.channel) continue;
+				
+				int rc;
+				while ((rc = libssh2_channel_read(attempt.channel, buffer, sizeof(buffer))) > 0) {
+					attempt.output.append(buffer, rc);
+					last_data = std::chrono::steady_clock::now(); // Reset timeout on data received
+				}
+				if (rc == LIBSSH2_ERROR_EAGAIN) continue;
+				
+				// EOF wins outright; an error only ends the request if no other attempt is still running
+				if (rc == 0 || !attempts[1 - i].channel) {
+					winner = i;
+				} else {
+					release(attempt, i == 1);
+				}
+			}
+			if (winner >= 0) break;
+			
+			auto now = std::chrono::steady_clock::now();
+			
+			// Past the adaptive p95: race a duplicate on a second channel, within the concurrency cap
+			if (!hedge_tried && hedge_after.count() > 0 && now - start_time > hedge_after) {
+				hedge_tried = true;
+				if (hedges_in_flight.fetch_add(1) < MAX_HEDGES_IN_FLIGHT) {
+					std::string hedge_error;
+					attempts[1].channel = open_exec_channel(session, command, timeout, hedge_error, cancel);
+					if (attempts[1].channel) {
+						hedged_++;
+						Logger::debug("SSHClient::execute: Hedging request after " + std::to_string(hedge_after.count()) + "ms");
+					} else {
+						hedges_in_flight--;
+						Logger::debug("SSHClient::execute: Hedge failed: " + hedge_error);
+					}
+				} else {
+					hedges_in_flight--;
+				}
+			}
+			
+			if (cancel.expired()) {
+				error_ = "Cancelled";
+				release(attempts[0], false);
+				release(attempts[1], true);
+				return "";
+			}
+			if (now - last_data > timeout) {
+				error_ = "Timeout reading command output (" + std::to_string(timeout.count()) + "ms)";
+				timeouts_++;
+				// Counted at the timeout it hit, so the next try of a server that got slower waits longer
+				latency_.record(kind, timeout.count());
+				release(attempts[0], false);
+				release(attempts[1], true);
 				return "";
 			}
-			usleep(10000);
+			
+			usleep(10000); // Sleep 10ms to avoid busy-waiting
 		}
 		
-		// Read output with timeout
-		std::ostringstream output;
-		char buffer[4096];
-		int rc;
-		start_time = std::chrono::steady_clock::now();
+		if (winner == 1) hedge_wins_++;
+		latency_.record(kind, std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - start_time).count());
 		
-		while (true) {
-			do {
-				rc = libssh2_channel_read(channel, buffer, sizeof(buffer));
-				if (rc > 0) {
-					output.write(buffer, rc);
-					start_time = std::chrono::steady_clock::now(); // Reset timeout on data received
+		std::string output = std::move(attempts[winner].output);
+		release(attempts[0], false);
+		release(attempts[1], true);
+		
+		return output;
+	}
+
+	//* Exec channel kept open, stdin is written and stdout read under the client's exec mutex
+	class SSHSession : public Session {
+	public:
+		SSHSession(SSHClient& client, LIBSSH2_CHANNEL* channel) : client_(client), channel_(channel) {}
+		
+		~SSHSession() override {
+			std::lock_guard lock(client_.exec_mutex_);
+			stop();
+		}
+		
+		std::string exchange(const std::string& input, std::string_view end_marker, std::chrono::milliseconds timeout,
+							 const Cancel& cancel) override {
+			//? Cancelled while waiting for the connection nothing was sent, the session stays usable
+			auto lock = lock_within(client_.exec_mutex_, cancel);
+			if (!lock.owns_lock() || !channel_ || !client_.session_) return "";
+			const Cancel until{cancel.stop, std::min(cancel.deadline, std::chrono::steady_clock::now() + timeout)};
+			
+			for (size_t sent = 0; sent < input.size();) {
+				ssize_t n = libssh2_channel_write(channel_, input.data() + sent, input.size() - sent);
+				if (n == LIBSSH2_ERROR_EAGAIN) {
+					if (until.expired()) return stop(cancel.expired() ? CANCEL_CLOSE_MS : std::chrono::milliseconds(1000));
+					usleep(10000);
+					continue;
 				}
-			} while (rc > 0);
+				if (n < 0) return stop();
+				sent += n;
+			}
 			
-			if (rc == LIBSSH2_ERROR_EAGAIN) {
-				if (std::chrono::steady_clock::now() - start_time > timeout) {
-					error_ = "Timeout reading command output";
-					libssh2_channel_close(channel);
-					libssh2_channel_free(channel);
-					return "";
+			std::string output;
+			char buffer[4096];
+			while (true) {
+				ssize_t rc;
+				while ((rc = libssh2_channel_read(channel_, buffer, sizeof(buffer))) > 0) {
+					output.append(buffer, rc);
 				}
-				usleep(10000); // Sleep 10ms to avoid busy-waiting
-				continue;
-			} else {
-				break;
+				if (size_t end = marker_line(output, end_marker); end != std::string::npos) {
+					output.resize(end);
+					return output;
+				}
+				// EOF or an error: the command is gone
+				if (rc != LIBSSH2_ERROR_EAGAIN) return stop();
+				if (until.expired()) return stop(cancel.expired() ? CANCEL_CLOSE_MS : std::chrono::milliseconds(1000));
+				usleep(10000);
 			}
 		}
 		
-		// Close channel with timeout
-		start_time = std::chrono::steady_clock::now();
-		while (libssh2_channel_close(channel) == LIBSSH2_ERROR_EAGAIN) {
-			if (std::chrono::steady_clock::now() - start_time > timeout) {
-				error_ = "Timeout closing SSH channel";
-				break;
-			}
-			usleep(10000);
-		}
+		bool alive() const override { return channel_ != nullptr; }
 		
-		libssh2_channel_free(channel);
+	private:
+		SSHClient& client_;
+		LIBSSH2_CHANNEL* channel_;
 		
-		return output.str();
+		std::string stop(std::chrono::milliseconds close_timeout = std::chrono::milliseconds(1000)) {
+			if (channel_ && client_.session_) close_channel(channel_, close_timeout);
+			channel_ = nullptr;
+			return "";
+		}
+	};
+	
+	std::unique_ptr<Session> SSHClient::open_session(const std::string& command, const Cancel& cancel) {
+		if (!session_) {
+			error_ = "Not connected";
+			return nullptr;
+		}
+		auto lock = lock_within(exec_mutex_, cancel);
+		if (!lock.owns_lock()) return nullptr;
+		const uint64_t kind = query_kind(command);
+		const uint64_t timeout_ms = latency_.timeout_ms(kind);
+		auto* channel = open_exec_channel(static_cast<LIBSSH2_SESSION*>(session_), command,
+										  std::chrono::milliseconds(timeout_ms), error_, cancel);
+		if (!channel) {
+			if (error_.starts_with("Timeout")) latency_.record(kind, timeout_ms);
+			return nullptr;
+		}
+		return std::make_unique<SSHSession>(*this, channel);
 	}
 
 	bool SSHClient::is_connected() const {
@@ -360,14 +885,177 @@ namespace AzerothCore {
 		return error_;
 	}
 
+	//* LoadBudget implementation
+	void LoadBudget::set_limit(uint64_t ms_per_minute) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		limit_ms_ = ms_per_minute;
+	}
+
+	void LoadBudget::expire(uint64_t now_ms) {
+		while (!samples_.empty() && now_ms - samples_.front().first > BUDGET_WINDOW_MS) {
+			window_ms_ -= samples_.front().second;
+			samples_.pop_front();
+		}
+	}
+
+	void LoadBudget::record(uint64_t cost_ms) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto now_ms = time_ms();
+		expire(now_ms);
+		samples_.emplace_back(now_ms, cost_ms);
+		window_ms_ += cost_ms;
+		total_ms_ += cost_ms;
+	}
+
+	uint64_t LoadBudget::total() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return total_ms_;
+	}
+
+	bool LoadBudget::admit(QueryPriority priority) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (limit_ms_ == 0 || priority == QueryPriority::CRITICAL) return true;
+		expire(time_ms());
+		
+		// Low priority sources are shed first, at half the budget, to leave headroom for the rest
+		uint64_t ceiling = (priority == QueryPriority::LOW) ? limit_ms_ / 2 : limit_ms_;
+		if (window_ms_ < ceiling) return true;
+		
+		shed_++;
+		return false;
+	}
+
+	uint64_t LoadBudget::full_cycle_spacing(uint64_t cycle_cost_ms) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		// Spacing at which back-to-back full cycles would spend exactly the budget
+		spacing_ms_ = (limit_ms_ == 0) ? 0 : cycle_cost_ms * BUDGET_WINDOW_MS / limit_ms_;
+		return spacing_ms_;
+	}
+
+	RttBudgetStats LoadBudget::stats() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		expire(time_ms());
+		return {window_ms_, limit_ms_, shed_, spacing_ms_};
+	}
+
+	std::string QueryCache::normalize(const std::string& command) {
+		std::string key;
+		key.reserve(command.size());
+		bool space = false;
+		for (char c : command) {
+			if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+				space = !key.empty();
+				continue;
+			}
+			if (space) key += ' ';
+			key += c;
+			space = false;
+		}
+		return key;
+	}
+
+	std::string QueryCache::get(const std::string& command, uint64_t ttl_ms, Fetcher fetch, const Cancel& cancel, Refreshes& refreshes) {
+		std::string key = normalize(command);
+		std::unique_lock<std::mutex> lock(mutex_);
+		
+		if (ttl_ms > 0) {
+			auto it = entries_.find(key);
+			if (it != entries_.end()) {
+				uint64_t age = time_ms() - it->second.fetched_ms;
+				if (age < ttl_ms) {
+					stats_.hits++;
+					return it->second.value;
+				}
+				if (age < ttl_ms * 2) {
+					stats_.stale_hits++;
+					if (!it->second.refresh_queued) {
+						it->second.refresh_queued = true;
+						refreshes.push_back({key, ttl_ms, std::move(fetch)});
+					}
+					return it->second.value;
+				}
+			}
+		}
+		
+		return fetch_shared(lock, key, ttl_ms, fetch, cancel);
+	}
+
+	std::string QueryCache::fetch_shared(std::unique_lock<std::mutex>& lock, const std::string& key, uint64_t ttl_ms, const Fetcher& fetch,
+										 const Cancel& cancel) {
+		// Someone else is already fetching this key, wait for their result
+		if (auto it = in_flight_.find(key); it != in_flight_.end()) {
+			stats_.coalesced++;
+			auto pending = it->second;
+			lock.unlock();
+			return pending.get();
+		}
+		
+		stats_.misses++;
+		std::promise<std::string> promise;
+		in_flight_[key] = promise.get_future().share();
+		lock.unlock();
+		
+		std::string value;
+		try {
+			value = fetch(cancel);
+		} catch (...) {
+			lock.lock();
+			in_flight_.erase(key);
+			lock.unlock();
+			promise.set_exception(std::current_exception());
+			throw;
+		}
+		
+		lock.lock();
+		in_flight_.erase(key);
+		if (ttl_ms > 0 && !value.empty()) {
+			entries_[key] = {value, time_ms(), false};
+		} else if (auto it = entries_.find(key); it != entries_.end()) {
+			it->second.refresh_queued = false;
+		}
+		lock.unlock();
+		promise.set_value(value);
+		return value;
+	}
+
+	void QueryCache::revalidate(Refreshes& refreshes, const Cancel& cancel) {
+		Refreshes pending;
+		pending.swap(refreshes);
+		for (const auto& refresh : pending) {
+			try {
+				std::unique_lock<std::mutex> lock(mutex_);
+				fetch_shared(lock, refresh.key, refresh.ttl_ms, refresh.fetch, cancel);
+			} catch (const std::exception& e) {
+				Logger::debug("QueryCache: refresh failed: " + std::string(e.what()));
+			}
+		}
+	}
+
+	void QueryCache::clear() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		entries_.clear();
+	}
+
+	CacheStats QueryCache::stats() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return stats_;
+	}
+
+	std::string CommandExecutor::execute_cached(const std::string& command, uint64_t ttl_ms, const Cancel& cancel,
+												QueryCache::Refreshes& refreshes) {
+		return query_cache.get(command, ttl_ms, [this, command](const Cancel& within) { return execute(command, within); }, cancel, refreshes);
+	}
+
 	//* Query implementation
-	Query::Query(CommandExecutor& executor, const ServerConfig& config)
-		: executor_(executor), config_(config) {
-		// Cache excluded account IDs on construction
-		cache_excluded_accounts();
+	Query::Query(CommandExecutor& executor, const ServerConfig& config, LoadBudget* budget, std::string cache_scope, Cancel cancel)
+		: executor_(executor), config_(config), budget_(budget ? *budget : load_budget), cache_scope_(std::move(cache_scope)),
+		  cancel_(std::move(cancel)) {}
+
+	void Query::revalidate() {
+		query_cache.revalidate(refresh_, cancel_);
 	}
 
-	std::string Query::mysql_exec(const std::string& query) {
+	std::string Query::mysql_exec(const std::string& query, QueryPriority priority, uint64_t ttl_ms) {
 	std::ostringstream cmd;
 	cmd << "docker exec " << config_.container 
 		<< " mysql -h" << config_.db_host
@@ -376,23 +1064,111 @@ namespace AzerothCore {
 		<< " -D" << config_.db_name
 		<< " -sN -e \"" << query << "\" 2>/dev/null";  // Suppress MySQL warnings
 	
-	Logger::error("MYSQL DEBUG: Executing command: " + cmd.str());
-	std::string result = executor_.execute(cmd.str());
-	Logger::error("MYSQL DEBUG: Got result (length=" + std::to_string(result.length()) + "): '" + result.substr(0, 100) + "'");
-	return result;
+	// Admission and budget accounting only apply to actual round trips, cache hits are free
+	// The fetch runs under the cancel it is handed: this call's on a miss, the cancel of the cycle that
+	// revalidates for a queued refresh, which may start long after this call's deadline has passed
+	return query_cache.get(cache_scope_ + cmd.str(), ttl_ms, [this, command = cmd.str(), priority](const Cancel& cancel) -> std::string {
+		if (!budget_.admit(priority)) {
+			Logger::debug("mysql_exec: Query shed by round-trip budget");
+			return "";
+		}
+		Logger::error("MYSQL DEBUG: Executing command: " + command);
+		auto start_ms = time_ms();
+		std::string result = executor_.execute(command, cancel);
+		budget_.record(time_ms() - start_ms);
+		Logger::error("MYSQL DEBUG: Got result (length=" + std::to_string(result.length()) + "): '" + result.substr(0, 100) + "'");
+		return result;
+	}, cancel_, refresh_);
+	}
+	
+	std::string Query::mysql_session_exec(const std::string& statements, QueryPriority priority) {
+		if (!budget_.admit(priority)) {
+			Logger::debug("mysql_session_exec: Statements shed by round-trip budget");
+			return "";
+		}
+		if (!mysql_session_ || !mysql_session_->alive()) {
+			// --force keeps the client running past a failed statement, --unbuffered flushes every result
+			std::ostringstream cmd;
+			cmd << "docker exec -i " << config_.container
+				<< " mysql -h" << config_.db_host
+				<< " -u" << config_.db_user
+				<< " -p" << config_.db_pass
+				<< " -D" << config_.db_name
+				<< " -sN --force --unbuffered 2>/dev/null";
+			mysql_session_ = executor_.open_session(cmd.str(), cancel_);
+			if (!mysql_session_) return "";
+		}
+		
+		auto start_ms = time_ms();
+		std::string result = mysql_session_->exchange(statements + "\nSELECT '" + std::string(SESSION_END_MARKER) + "';\n",
+			SESSION_END_MARKER, std::chrono::milliseconds(SESSION_TIMEOUT_MS), cancel_);
+		budget_.record(time_ms() - start_ms);
+		if (!mysql_session_->alive()) {
+			Logger::debug("mysql_session_exec: Session ended, reopening on next use");
+			mysql_session_.reset();
+		}
+		return result;
+	}
+	
+	DbHealth Query::fetch_health() {
+		std::string result = mysql_session_exec(
+			"SHOW GLOBAL STATUS WHERE Variable_name IN ('Questions', 'Slow_queries', 'Innodb_buffer_pool_read_requests', "
+			"'Innodb_buffer_pool_reads', 'Innodb_rows_read', 'Innodb_rows_inserted', 'Innodb_rows_updated', 'Innodb_rows_deleted', "
+			"'Threads_running', 'Threads_connected', 'Uptime');\n"
+			"SHOW GLOBAL VARIABLES WHERE Variable_name = 'max_connections';");
+		
+		std::unordered_map<std::string, int64_t> status;
+		for (const auto& row : Mysql::rows<std::string_view, int64_t>(result)) {
+			if (!row) continue;
+			auto [name, value] = *row;
+			status[std::string(name)] = value;
+		}
+		auto get = [&status](const char* name) { auto it = status.find(name); return it == status.end() ? 0 : it->second; };
+		
+		const uint64_t now = time_ms();
+		auto& h = health_;
+		h.available = status.contains("Uptime");
+		if (h.available) {
+			// Counters restart with the server, a lower uptime means no usable previous sample
+			h.rates = !last_status_.empty() && get("Uptime") >= last_status_["Uptime"] && now > last_health_ms_;
+			if (h.rates) {
+				const double seconds = (now - last_health_ms_) / 1000.0;
+				auto delta = [&](const char* name) { return std::max<int64_t>(0, get(name) - last_status_[name]); };
+				const int64_t requests = delta("Innodb_buffer_pool_read_requests");
+				h.qps = delta("Questions") / seconds;
+				h.slow_per_s = delta("Slow_queries") / seconds;
+				h.hit_pct = requests > 0 ? 100.0 * (1.0 - std::min<double>(delta("Innodb_buffer_pool_reads"), requests) / requests) : 100.0;
+				h.reads_per_s = delta("Innodb_rows_read") / seconds;
+				h.writes_per_s = (delta("Innodb_rows_inserted") + delta("Innodb_rows_updated") + delta("Innodb_rows_deleted")) / seconds;
+			}
+			h.threads_running = (int)get("Threads_running");
+			h.threads_connected = (int)get("Threads_connected");
+			h.max_connections = (int)get("max_connections");
+			h.uptime_s = get("Uptime");
+			last_status_ = std::move(status);
+			last_health_ms_ = now;
+		}
+		else {
+			h.rates = false;
+		}
+		
+		h.qps_history.push(h.rates ? h.qps : -1.0);
+		h.slow_history.push(h.rates ? h.slow_per_s : -1.0);
+		h.hit_history.push(h.rates ? h.hit_pct : -1.0);
+		h.reads_history.push(h.rates ? h.reads_per_s : -1.0);
+		h.writes_history.push(h.rates ? h.writes_per_s : -1.0);
+		h.running_history.push(h.available ? h.threads_running : -1.0);
+		h.connected_history.push(h.available ? h.threads_connected : -1.0);
+		return h;
 	}
 	
 	void Query::cache_excluded_accounts() {
 		// Fetch account IDs for excluded usernames once and cache them
-		std::string result = mysql_exec(
-			"SELECT GROUP_CONCAT(id) FROM acore_auth.account "
-			"WHERE username IN ('HAVOC','JOSHG','JOSHR','JON','CAITR','COLTON','KELSEYG','KYLAN','SETH','AHBOT');"
-		);
-		
-		if (!result.empty() && result != "NULL") {
-			excluded_account_ids_ = result;
-			// Remove any trailing whitespace/newlines
-			excluded_account_ids_.erase(excluded_account_ids_.find_last_not_of(" \n\r\t") + 1);
+		std::string result = mysql_exec(sql_excluded_accounts(), QueryPriority::CRITICAL, ACCOUNTS_TTL_MS);
+		
+		auto ids = Mysql::scalar<std::string_view>(result);
+		if (ids && !ids->empty() && *ids != "NULL") {
+			excluded_account_ids_ = std::string(*ids);
 		} else {
 			// If no accounts found, use impossible ID to avoid syntax errors
 			excluded_account_ids_ = "-1";
@@ -403,23 +1179,424 @@ namespace AzerothCore {
 	
 	std::string Query::get_excluded_accounts_filter() {
 		// Return optimized filter using cached account IDs
+		if (excluded_account_ids_.empty()) cache_excluded_accounts();
 		return "account NOT IN (" + excluded_account_ids_ + ")";
 	}
 
-	BotStats Query::fetch_bot_stats() {
-	BotStats stats;
-	
-	Logger::error("FETCH DEBUG: fetch_bot_stats() starting");
-	
+	int sample_size(double margin, int population) {
+		if (margin <= 0.0 || population <= 0) return population;
+		double n0 = SAMPLE_Z * SAMPLE_Z * 0.25 / (margin * margin);
+		double n = n0 / (1.0 + (n0 - 1.0) / population);
+		return std::min(population, (int)std::ceil(n));
+	}
+
+	double margin_of_error(int hits, int sample, int population) {
+		if (sample <= 0 || population <= sample) return 0.0;
+		double p = (double)hits / sample;
+		double fpc = (double)(population - sample) / std::max(population - 1, 1);
+		return SAMPLE_Z * std::sqrt(p * (1.0 - p) / sample * fpc) * 100.0;
+	}
+
+	namespace {
+		//* Scale sampled bracket counts up to estimates and attach their margins
+		void sample_levels(std::vector<LevelBracket>& levels, const SamplePlan& plan) {
+			if (!plan.active()) return;
+			for (auto& lb : levels) {
+				lb.margin = margin_of_error(lb.count, plan.sampled, plan.population);
+				lb.count = (int)std::lround(lb.count * plan.scale());
+			}
+		}
+	}
+
+	std::string Query::get_sample_filter(const std::string& guid_column) {
+		if (!sample_.active()) return "";
+		return " AND " + guid_column + " % " + std::to_string(sample_.modulus) + " = " + std::to_string(sample_.residue);
+	}
+
+	//* SQL of the collection queries, shared by the fetchers and the advisor
+	std::string Query::sql_excluded_accounts() {
+		return "SELECT GROUP_CONCAT(id) FROM acore_auth.account "
+			"WHERE username IN (" + std::string(EXCLUDED_USERNAMES) + ");";
+	}
+
+	std::string Query::sql_bot_count() {
+		// Optimized query - use cached excluded account IDs (no subquery needed)
+		return "SELECT COUNT(*) FROM characters "
+			"WHERE online = 1 "
+			"AND " + get_excluded_accounts_filter() + ";";
+	}
+
+	std::string Query::sql_continents() {
+		return "SELECT continent, SUM(count) as total_count FROM ( "
+			"  SELECT "
+			"    CASE map "
+			"      WHEN 0 THEN 'Eastern Kingdoms' "
+			"      WHEN 1 THEN 'Kalimdor' "
+			"      WHEN 530 THEN 'Outland' "
+			"      WHEN 571 THEN 'Northrend' "
+			"      WHEN 609 THEN 'Eastern Kingdoms' "
+			"      WHEN 30 THEN 'Battlegrounds' "
+			"      WHEN 489 THEN 'Battlegrounds' "
+			"      WHEN 529 THEN 'Battlegrounds' "
+			"      ELSE 'Instances' "
+			"    END as continent, "
+			"    COUNT(*) as count "
+			"  FROM characters "
+			"  WHERE online = 1 "
+			"    AND " + get_excluded_accounts_filter() + get_sample_filter() + " "
+			"  GROUP BY map "
+			") as map_counts "
+			"GROUP BY continent "
+			"ORDER BY total_count DESC;";
+	}
+
+	std::string Query::sql_factions() {
+		return "SELECT "
+			"  CASE "
+			"    WHEN c.race IN (1,3,4,7,11) THEN 'Alliance' "
+			"    WHEN c.race IN (2,5,6,8,10) THEN 'Horde' "
+			"    ELSE 'Neutral' "
+			"  END as faction, "
+			"  COUNT(*) as count "
+			"FROM characters c "
+			"WHERE c.online = 1 "
+			"  AND " + get_excluded_accounts_filter() + get_sample_filter("c.guid") + " "
+			"GROUP BY faction "
+			"ORDER BY count DESC;";
+	}
+
+	std::string Query::sql_zone_histogram() {
+		// Online bots per (zone, level, race, class). Zone totals, level ranges, alignment, zone details,
+		// the global level brackets and the pivot cube are all derived from it.
+		return "SELECT "
+			"  zone, "
+			"  level, "
+			"  race, "
+			"  class, "
+			"  COUNT(*) "
+			"FROM characters "
+			"WHERE online = 1 "
+			"  AND " + get_excluded_accounts_filter() + get_sample_filter() + " "
+			"GROUP BY zone, level, race, class;";
+	}
+
+	std::vector<Advisor::QuerySpec> Query::collection_queries() {
+		// Secondary indexes carry the primary key, so guid is never listed for the sampling filter
+		return {
+			{"excluded_accts", sql_excluded_accounts(), "acore_auth.account", {"username"}, {}, {"id"}},
+			{"bot_count", sql_bot_count(), "characters", {"online"}, {}, {"account"}},
+			{"continents", sql_continents(), "characters", {"online"}, {"map"}, {"account"}},
+			{"factions", sql_factions(), "characters", {"online"}, {}, {"race", "account"}},
+			{"zone_histogram", sql_zone_histogram(), "characters", {"online"}, {"zone", "level", "race", "class"}, {"account"}},
+		};
+	}
+
+	Advisor::Report Query::advise() {
+		// Direct round trips: no cache, and CRITICAL so the load budget never sheds them
+		return Advisor::run(collection_queries(), [this](const std::string& sql) {
+			return mysql_exec(sql, QueryPriority::CRITICAL);
+		});
+	}
+
+	namespace {
+		//* Continent of a map id, same mapping as sql_continents()
+		std::string map_continent(int map) {
+			switch (map) {
+				case 0: case 609: return "Eastern Kingdoms";
+				case 1: return "Kalimdor";
+				case 530: return "Outland";
+				case 571: return "Northrend";
+				case 30: case 489: case 529: return "Battlegrounds";
+				default: return "Instances";
+			}
+		}
+
+		//* Sort by count descending and fill in percentages of the total
+		template<typename T>
+		void finish_distribution(std::vector<T>& items) {
+			int total = 0;
+			for (const auto& item : items) total += item.count;
+			std::sort(items.begin(), items.end(), [](const T& a, const T& b) { return a.count > b.count; });
+			for (auto& item : items) {
+				if (total > 0) item.percent = (item.count * 100.0) / total;
+			}
+		}
+
+		//* Zones from their level histograms, sorted by continent, region and bots. all_levels gets the sum.
+		std::vector<Zone> build_zones(std::unordered_map<int, LevelHistogram>& histograms, LevelHistogram& all_levels) {
+			std::vector<Zone> zones;
+			
+			all_levels = LevelHistogram();
+			for (auto& [zone_id, histogram] : histograms) {
+				histogram.finalize();
+				all_levels.merge(histogram);
+			
+				Zone z;
+				z.zone_id = zone_id;  // Store zone ID for detail queries
+				z.name = AzerothCore::get_zone_name(zone_id);  // Use hardcoded zone name map
+			
+				// Get continent and region metadata
+				auto metadata = AzerothCore::get_zone_metadata(zone_id);
+				z.continent = metadata.continent;
+				z.region = metadata.region;
+			
+				z.total = histogram.total();
+			
+				// Store expected levels from metadata
+				z.expected_min = metadata.min_level;
+				z.expected_max = metadata.max_level;
+			
+				// Store actual bot levels from database
+				z.actual_min = histogram.min_level();
+				z.actual_max = histogram.max_level();
+			
+				// Alignment percentage = (bots in correct range / total bots) * 100
+				if (z.expected_min > 0 && z.expected_max > 0 && z.total > 0) {
+					z.alignment = (histogram.count(z.expected_min, z.expected_max) * 100.0) / z.total;
+				}
+			
+				z.levels = std::move(histogram);
+				zones.push_back(std::move(z));
+			}
+			all_levels.finalize();
+			
+			// Sort zones hierarchically: by continent, then region, then total descending
+			std::sort(zones.begin(), zones.end(), [](const Zone& a, const Zone& b) {
+				bool a_unknown = a.continent == "Unknown";
+				bool b_unknown = b.continent == "Unknown";
+			
+				// Unknown zones go to the bottom
+				if (a_unknown != b_unknown) {
+					return !a_unknown;
+				}
+			
+				// Sort by continent
+				if (a.continent != b.continent) {
+					// Order: Eastern Kingdoms, Kalimdor, Outland, Northrend, Unknown
+					const std::vector<std::string> continent_order = {"Eastern Kingdoms", "Kalimdor", "Outland", "Northrend"};
+					auto a_it = std::find(continent_order.begin(), continent_order.end(), a.continent);
+					auto b_it = std::find(continent_order.begin(), continent_order.end(), b.continent);
+			
+					if (a_it != continent_order.end() && b_it != continent_order.end()) {
+						return a_it < b_it;
+					}
+					return a.continent < b.continent;
+				}
+			
+				// Same continent: sort by region
+				if (a.region != b.region) {
+					return a.region < b.region;
+				}
+			
+				// Same continent and region: sort by total descending
+				return a.total > b.total;
+			});
+			
+			return zones;
+		}
+	}
+
+	std::vector<std::string> Query::summary_ddl() {
+		const std::string table = SUMMARY_TABLE;
+		return {
+			"CREATE TABLE IF NOT EXISTS " + table + " ( "
+			"  zone SMALLINT UNSIGNED NOT NULL, "
+			"  map SMALLINT UNSIGNED NOT NULL, "
+			"  race TINYINT UNSIGNED NOT NULL, "
+			"  class TINYINT UNSIGNED NOT NULL, "
+			"  level TINYINT UNSIGNED NOT NULL, "
+			"  total INT UNSIGNED NOT NULL, "
+			"  refreshed DATETIME NOT NULL, "
+			"  PRIMARY KEY (zone, map, race, class, level), "
+			"  KEY idx_refreshed (refreshed) "
+			") ENGINE=InnoDB;",
+			// A single statement per run, so no DELIMITER games: the current snapshot shares one NOW(),
+			// groups that emptied keep an older timestamp, are skipped by sql_summary() and pruned later
+			"CREATE EVENT IF NOT EXISTS " + table + "_refresh "
+			"ON SCHEDULE EVERY " + std::to_string(SUMMARY_REFRESH_S) + " SECOND "
+			"DO INSERT INTO " + table + " (zone, map, race, class, level, total, refreshed) "
+			"  SELECT zone, map, race, class, level, COUNT(*), NOW() "
+			"  FROM characters "
+			"  WHERE online = 1 "
+			"    AND account NOT IN (SELECT id FROM acore_auth.account WHERE username IN (" + EXCLUDED_USERNAMES + ")) "
+			"  GROUP BY zone, map, race, class, level "
+			"ON DUPLICATE KEY UPDATE total = VALUES(total), refreshed = VALUES(refreshed);",
+			"CREATE EVENT IF NOT EXISTS " + table + "_prune "
+			"ON SCHEDULE EVERY 10 MINUTE "
+			"DO DELETE FROM " + table + " WHERE refreshed < NOW() - INTERVAL 10 MINUTE;",
+		};
+	}
+
+	bool Query::install_summary() {
+		for (const auto& statement : summary_ddl()) {
+			mysql_exec(statement, QueryPriority::CRITICAL);
+		}
+		// mysql errors are not captured, read back what exists instead
+		query_cache.clear();
+		detect_summary();
+		return summary_ready_ || (summary_.installed && summary_.reason.starts_with("event_scheduler"));
+	}
+
+	std::string Query::sql_summary() {
+		const std::string table = SUMMARY_TABLE;
+		return "SELECT TIMESTAMPDIFF(SECOND, refreshed, NOW()), zone, map, race, class, level, total "
+			"FROM " + table + " "
+			"WHERE refreshed = (SELECT MAX(refreshed) FROM " + table + ");";
+	}
+
+	void Query::detect_summary() {
+		const std::string table = SUMMARY_TABLE;
+		std::string result = mysql_exec(
+			"SELECT "
+			"  (SELECT COUNT(*) FROM information_schema.TABLES WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = '" + table + "'), "
+			"  (SELECT COUNT(*) FROM information_schema.EVENTS "
+			"    WHERE EVENT_SCHEMA = DATABASE() AND EVENT_NAME = '" + table + "_refresh' AND STATUS = 'ENABLED'), "
+			"  (SELECT COUNT(*) FROM information_schema.COLUMNS "
+			"    WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = '" + table + "' AND COLUMN_NAME = 'class'), "
+			"  @@event_scheduler;",
+			QueryPriority::CRITICAL, DISCOVERY_TTL_MS);
+		next_summary_check_ = time_ms() + SUMMARY_CHECK_MS;
+		
+		summary_.installed = false;
+		summary_ready_ = false;
+		for (const auto& row : Mysql::rows<int, int, int, std::string_view>(result)) {
+			if (!row) continue;
+			auto [tables, events, class_columns, scheduler] = *row;
+			summary_.installed = tables > 0;
+			if (!summary_.installed) summary_.reason.clear();
+			else if (class_columns == 0) summary_.reason = "old layout without race and class, drop it and reinstall";
+			else if (events == 0) summary_.reason = "refresh event missing or disabled";
+			else if (scheduler != "ON") summary_.reason = "event_scheduler is " + std::string(scheduler);
+			else summary_ready_ = true;
+		}
+		Logger::debug("detect_summary: installed=" + std::to_string(summary_.installed) + " ready=" + std::to_string(summary_ready_));
+	}
+
+	bool Query::fetch_summary(ServerData& data) {
+		auto start_ms = time_ms();
+		std::string result = mysql_exec(sql_summary(), QueryPriority::CRITICAL);
+		
+		std::unordered_map<int, LevelHistogram> histograms;
+		std::unordered_map<std::string, int> continents;
+		std::array<int, 3> factions{};
+		auto cube = std::make_shared<BotCube>();
+		int total = 0;
+		int age = -1;
+		for (const auto& row : Mysql::rows<int, int, int, int, int, int, int>(result)) {
+			if (!row) continue;
+			auto [row_age, zone, map, race, class_id, level, count] = *row;
+			const int faction = race_faction(race);
+			age = row_age;
+			total += count;
+			continents[map_continent(map)] += count;
+			factions[faction] += count;
+			histograms[zone].add(level, count, faction == 0 ? count : 0, faction == 1 ? count : 0);
+			cube->add(zone, level, race, class_id, count);
+		}
+		
+		// No rows: dropped since the last detection, never refreshed, or not a single bot online
+		if (age < 0) {
+			summary_.reason = "no current rows";
+			return false;
+		}
+		summary_.age_s = age;
+		if (age > SUMMARY_STALE_S) {
+			summary_.reason = "stale, " + std::to_string(age) + "s old";
+			return false;
+		}
+		summary_.reason.clear();
+		
+		data.stats.total = total;
+		data.stats.update_time_avg = time_ms() - start_ms;
+		for (const auto& [name, count] : continents) {
+			Continent c;
+			c.name = name;
+			c.count = count;
+			data.continents.push_back(c);
+		}
+		finish_distribution(data.continents);
+		const std::array<const char*, 3> faction_names = {"Alliance", "Horde", "Neutral"};
+		for (size_t i = 0; i < factions.size(); i++) {
+			if (factions[i] == 0) continue;
+			Faction f;
+			f.name = faction_names[i];
+			f.count = factions[i];
+			data.factions.push_back(f);
+		}
+		finish_distribution(data.factions);
+		data.zones = build_zones(histograms, data.level_histogram);
+		cube->finalize();
+		data.cube = std::move(cube);
+		return true;
+	}
+
+	bool Query::verify_summary(BotStats& stats) {
+		const int summary_total = stats.total;
+		count_bots(stats);
+		next_summary_verify_ = time_ms() + SUMMARY_VERIFY_MS;
+		
+		// Bots log in and out between event runs, allow for that before calling it drift
+		summary_.drift = summary_total - stats.total;
+		const int tolerance = std::max(10, stats.total / 20);
+		summary_drifted_ = std::abs(summary_.drift) > tolerance;
+		if (summary_drifted_) {
+			summary_.reason = "drift " + std::to_string(summary_.drift) + " from exact count";
+			Logger::warning("Summary table drifted by " + std::to_string(summary_.drift) + " bots, reading characters until the next check");
+		}
+		return !summary_drifted_;
+	}
+
+	void Query::plan_sample(int population, bool exact) {
+		SamplePlan plan;
+		plan.population = population;
+		if (!exact && config_.sample_margin > 0 && population > 0) {
+			int n = sample_size(config_.sample_margin / 1000.0, population);
+			plan.modulus = std::max(1, population / std::max(n, 1));
+			// Continue the rotation so consecutive cycles look at different bots
+			if (plan.active()) plan.residue = (sample_.residue + 1) % plan.modulus;
+		}
+		sample_ = plan;
+	}
+
+	void Query::apply_sample(ServerData& data) {
+		sample_.sampled = data.level_histogram.total();
+		data.sample = sample_;
+		if (!sample_.active()) return;
+		
+		const int population = sample_.population;
+		auto estimate = [](auto& items) {
+			int n = 0;
+			for (const auto& item : items) n += item.count;
+			return n;
+		};
+		
+		int n = estimate(data.continents);
+		for (auto& c : data.continents) {
+			c.margin = margin_of_error(c.count, n, population);
+			if (n > 0) c.count = (int)std::lround((double)c.count * population / n);
+		}
+		n = estimate(data.factions);
+		for (auto& f : data.factions) {
+			f.margin = margin_of_error(f.count, n, population);
+			if (n > 0) f.count = (int)std::lround((double)f.count * population / n);
+		}
+		sample_levels(data.levels, data.sample);
+		
+		const double scale = sample_.scale();
+		for (auto& z : data.zones) {
+			int in_range = (int)std::lround(z.alignment * z.total / 100.0);
+			int zone_population = (int)std::lround(z.total * scale);
+			z.alignment_margin = margin_of_error(in_range, z.total, zone_population);
+			z.total = zone_population;
+		}
+	}
+
+	void Query::count_bots(BotStats& stats) {
 	// Measure query performance by timing a simple count query
 	auto query_start = std::chrono::high_resolution_clock::now();
 	
 	// Optimized query - use cached excluded account IDs (no subquery needed)
-	std::string result = mysql_exec(
-		"SELECT COUNT(*) FROM characters "
-		"WHERE online = 1 "
-		"AND " + get_excluded_accounts_filter() + ";"
-	);
+	std::string result = mysql_exec(sql_bot_count(), QueryPriority::CRITICAL);
 	
 	Logger::error("FETCH DEBUG: Bot count query returned: '" + result + "'");
 	
@@ -429,18 +1606,26 @@ namespace AzerothCore {
 	// Store the total round-trip query time (SSH + Docker + MySQL)
 	stats.update_time_avg = query_duration.count();
 	
-	if (!result.empty()) {
-		stats.total = std::stoi(result);
+	if (auto total = Mysql::scalar<int>(result)) {
+		stats.total = *total;
 		Logger::error("FETCH DEBUG: Parsed total=" + std::to_string(stats.total));
 	} else {
-		Logger::error("FETCH DEBUG: Empty result!");
+		Logger::error("FETCH DEBUG: Empty or malformed result!");
+	}
 	}
+
+	BotStats Query::fetch_bot_stats(bool count) {
+	BotStats stats;
+	
+	Logger::error("FETCH DEBUG: fetch_bot_stats() starting");
+	
+	if (count) count_bots(stats);
 	
 	// Get server uptime from container start time
 	std::ostringstream cmd;
 	cmd << "docker inspect " << config_.container << " --format='{{.State.StartedAt}}'";
 	
-	result = executor_.execute(cmd.str());
+	std::string result = executor_.execute(cmd.str(), cancel_);
 	if (!result.empty()) {
 		// Parse ISO 8601 timestamp: 2025-12-11T16:27:03.505639176Z
 		// Extract year, month, day, hour, minute, second
@@ -479,12 +1664,12 @@ namespace AzerothCore {
 		).count();
 		
 		// If less than 1 second since last update, return cached data
-		if (last_perf_update_time > 0 && 
-			(now_ms - last_perf_update_time) < PERF_UPDATE_INTERVAL_MS &&
-			last_known_perf.available) {
+		if (last_perf_ms_ > 0 && 
+			(now_ms - last_perf_ms_) < PERF_UPDATE_INTERVAL_MS &&
+			last_perf_.available) {
 			Logger::debug("fetch_server_performance: Using cached data (age: " + 
-				std::to_string(now_ms - last_perf_update_time) + "ms)");
-			return last_known_perf;
+				std::to_string(now_ms - last_perf_ms_) + "ms)");
+			return last_perf_;
 		}
 		
 		::AzerothCore::ServerPerformance perf;
@@ -510,273 +1695,31 @@ namespace AzerothCore {
 		<< "' 2>&1";
 	
 	Logger::debug("fetch_server_performance: Executing: " + cmd.str());
-	std::string result = executor_.execute(cmd.str());
+	std::string result = executor_.execute(cmd.str(), cancel_);
 	Logger::debug("fetch_server_performance: Result length: " + std::to_string(result.length()));
 	
-	// Debug: write to file
-	std::ofstream debug_file("/tmp/bottop_debug.txt", std::ios::app);
-	debug_file << "=== fetch_server_performance ===" << std::endl;
-	debug_file << "Command: " << cmd.str() << std::endl;
-	debug_file << "Result length: " << result.length() << std::endl;
-	debug_file << "Result: " << result << std::endl;
-	
 	if (result.empty()) {
-		debug_file << "Empty result, returning" << std::endl;
-		debug_file.close();
 		Logger::debug("fetch_server_performance: Empty result from server info command");
 		return perf;
 	}
 	
-	// Strip ANSI escape codes
-	std::regex ansi_regex("\033\\[[0-9;]*[mKH]|\\[\\?[0-9]+[lh]");
-	result = std::regex_replace(result, ansi_regex, "");
-	
-	// Filter out bot logging lines
-	std::istringstream pre_stream(result);
-	std::ostringstream filtered;
-	std::string pre_line;
-	while (std::getline(pre_stream, pre_line)) {
-		// Skip bot logging lines
-		if (pre_line.find("[BotLevelBrackets]") != std::string::npos ||
-			pre_line.find("AHBot") != std::string::npos ||
-			pre_line.find("spawn docker") != std::string::npos ||
-			pre_line.find("read escape sequence") != std::string::npos) {
-			continue;
-		}
-		filtered << pre_line << "\n";
-	}
-	result = filtered.str();
-	
-	debug_file << "Filtered result: " << result << std::endl;
-	debug_file.close();
-		
-		// Parse the output line by line
-		// Example:
-		// AzerothCore rev. ece1060fa05d+ 2025-12-12 19:37:01 +0000 (Testing-Playerbot branch) (Unix, RelWithDebInfo, Static)
-		// Connected players: 1. Characters in world: 3063.
-		// Connection peak: 1.
-		// Server uptime: 9 hour(s) 35 minute(s) 54 second(s)
-		// Update time diff: 41ms. Last 500 diffs summary:
-		// |- Mean: 120ms
-		// |- Median: 106ms
-		// |- Percentiles (95, 99, max): 243ms, 278ms, 314ms
-		
-		std::istringstream stream(result);
-	std::string line;
-	
-	while (std::getline(stream, line)) {
-		// Strip "AC>" prefix if present
-		if (line.find("AC>") == 0) {
-			line = line.substr(3);
-			// Trim leading whitespace
-			line.erase(0, line.find_first_not_of(" \t"));
-		}
-		
-		// Skip empty lines
-		if (line.empty()) continue;
-		
-		// Parse "AzerothCore rev. ece1060fa05d+ 2025-12-12 19:37:01 +0000 (Testing-Playerbot branch) (Unix, RelWithDebInfo, Static)"
-		if (line.find("AzerothCore rev.") != std::string::npos) {
-				// Extract revision
-				size_t rev_pos = line.find("rev. ");
-				if (rev_pos != std::string::npos) {
-					std::string rest = line.substr(rev_pos + 5);
-					size_t space_pos = rest.find(' ');
-					if (space_pos != std::string::npos) {
-						perf.revision = rest.substr(0, space_pos);
-					}
-				}
-				
-				// Extract branch name from parentheses
-				size_t branch_start = line.find("(");
-				size_t branch_end = line.find(" branch)");
-				if (branch_start != std::string::npos && branch_end != std::string::npos) {
-					perf.branch = line.substr(branch_start + 1, branch_end - branch_start - 1);
-				}
-				
-				// Extract build type (RelWithDebInfo, Debug, Release)
-				size_t build_start = line.rfind("(");
-				size_t build_end = line.rfind(")");
-				if (build_start != std::string::npos && build_end != std::string::npos) {
-					std::string build_info = line.substr(build_start + 1, build_end - build_start - 1);
-					// Parse "Unix, RelWithDebInfo, Static"
-					std::istringstream build_stream(build_info);
-					std::string token;
-					int count = 0;
-					while (std::getline(build_stream, token, ',')) {
-						token.erase(0, token.find_first_not_of(" \t"));
-						token.erase(token.find_last_not_of(" \t") + 1);
-						if (count == 1) {  // Second token is build type
-							perf.build_type = token;
-							break;
-						}
-						count++;
-					}
-				}
-				
-				// Extract build date (between rev and first paren)
-				size_t date_start = line.find(" ", rev_pos + 15);  // After revision hash
-				size_t date_end = line.find("(", date_start);
-				if (date_start != std::string::npos && date_end != std::string::npos) {
-					perf.build_date = line.substr(date_start + 1, date_end - date_start - 2);
-					perf.build_date.erase(0, perf.build_date.find_first_not_of(" \t"));
-					perf.build_date.erase(perf.build_date.find_last_not_of(" \t") + 1);
-				}
-			}
-			// Parse "Connected players: 1. Characters in world: 3063."
-			else if (line.find("Connected players:") != std::string::npos) {
-				// Extract connected players
-				size_t pos = line.find("Connected players:");
-				if (pos != std::string::npos) {
-					std::string rest = line.substr(pos + 18);
-					size_t dot_pos = rest.find('.');
-					if (dot_pos != std::string::npos) {
-						std::string num_str = rest.substr(0, dot_pos);
-						num_str.erase(0, num_str.find_first_not_of(" \t"));
-						num_str.erase(num_str.find_last_not_of(" \t") + 1);
-						perf.connected_players = std::stoi(num_str);
-					}
-				}
-				
-				// Extract characters in world
-				size_t chars_pos = line.find("Characters in world:");
-				if (chars_pos != std::string::npos) {
-					std::string rest = line.substr(chars_pos + 20);
-					size_t dot_pos = rest.find('.');
-					if (dot_pos != std::string::npos) {
-						std::string num_str = rest.substr(0, dot_pos);
-						num_str.erase(0, num_str.find_first_not_of(" \t"));
-						num_str.erase(num_str.find_last_not_of(" \t") + 1);
-						perf.characters_in_world = std::stoi(num_str);
-					}
-				}
-			}
-			// Parse "Connection peak: 1."
-			else if (line.find("Connection peak:") != std::string::npos) {
-				size_t pos = line.find(":");
-				if (pos != std::string::npos) {
-					std::string rest = line.substr(pos + 1);
-					size_t dot_pos = rest.find('.');
-					if (dot_pos != std::string::npos) {
-						std::string num_str = rest.substr(0, dot_pos);
-						num_str.erase(0, num_str.find_first_not_of(" \t"));
-						num_str.erase(num_str.find_last_not_of(" \t") + 1);
-						perf.connection_peak = std::stoi(num_str);
-					}
-				}
-			}
-			// Parse "Server uptime: 9 hour(s) 35 minute(s) 54 second(s)"
-			else if (line.find("Server uptime:") != std::string::npos) {
-				size_t pos = line.find(":");
-				if (pos != std::string::npos) {
-					perf.uptime = line.substr(pos + 2);  // Skip ": "
-					
-					// Calculate total seconds
-					long long hours = 0, minutes = 0, seconds = 0;
-					std::istringstream uptime_stream(perf.uptime);
-					std::string token;
-					while (uptime_stream >> token) {
-						if (std::isdigit(token[0])) {
-							long long value = std::stoll(token);
-							std::string next;
-							uptime_stream >> next;
-							if (next.find("hour") != std::string::npos) {
-								hours = value;
-							} else if (next.find("minute") != std::string::npos) {
-								minutes = value;
-							} else if (next.find("second") != std::string::npos) {
-								seconds = value;
-							}
-						}
-					}
-					perf.uptime_seconds = hours * 3600 + minutes * 60 + seconds;
-				}
-			}
-			// Parse "Update time diff: 41ms"
-			else if (line.find("Update time diff:") != std::string::npos) {
-				size_t pos = line.find(":");
-				if (pos != std::string::npos) {
-					std::string value_str = line.substr(pos + 1);
-					// Extract number before "ms"
-					size_t ms_pos = value_str.find("ms");
-					if (ms_pos != std::string::npos) {
-						value_str = value_str.substr(0, ms_pos);
-						// Trim whitespace
-						value_str.erase(0, value_str.find_first_not_of(" \t"));
-						value_str.erase(value_str.find_last_not_of(" \t") + 1);
-						perf.update_time_diff = std::stoll(value_str);
-					}
-				}
-			}
-			// Parse "|- Mean: 120ms"
-			else if (line.find("Mean:") != std::string::npos) {
-				size_t pos = line.find(":");
-				if (pos != std::string::npos) {
-					std::string value_str = line.substr(pos + 1);
-					size_t ms_pos = value_str.find("ms");
-					if (ms_pos != std::string::npos) {
-						value_str = value_str.substr(0, ms_pos);
-						value_str.erase(0, value_str.find_first_not_of(" \t"));
-						value_str.erase(value_str.find_last_not_of(" \t") + 1);
-						perf.mean = std::stoll(value_str);
-					}
-				}
-			}
-			// Parse "|- Median: 106ms"
-			else if (line.find("Median:") != std::string::npos) {
-				size_t pos = line.find(":");
-				if (pos != std::string::npos) {
-					std::string value_str = line.substr(pos + 1);
-					size_t ms_pos = value_str.find("ms");
-					if (ms_pos != std::string::npos) {
-						value_str = value_str.substr(0, ms_pos);
-						value_str.erase(0, value_str.find_first_not_of(" \t"));
-						value_str.erase(value_str.find_last_not_of(" \t") + 1);
-						perf.median = std::stoll(value_str);
-					}
-				}
-			}
-			// Parse "|- Percentiles (95, 99, max): 243ms, 278ms, 314ms"
-			else if (line.find("Percentiles") != std::string::npos) {
-				size_t colon_pos = line.find(":");
-				if (colon_pos != std::string::npos) {
-					std::string values_str = line.substr(colon_pos + 1);
-					// Split by comma
-					std::istringstream values_stream(values_str);
-					std::string p95_str, p99_str, max_str;
-					
-					if (std::getline(values_stream, p95_str, ',') &&
-						std::getline(values_stream, p99_str, ',') &&
-						std::getline(values_stream, max_str, ',')) {
-						
-						// Extract numbers
-						size_t ms_pos = p95_str.find("ms");
-						if (ms_pos != std::string::npos) {
-							p95_str = p95_str.substr(0, ms_pos);
-							p95_str.erase(0, p95_str.find_first_not_of(" \t"));
-							p95_str.erase(p95_str.find_last_not_of(" \t") + 1);
-							perf.p95 = std::stoll(p95_str);
-						}
-						
-						ms_pos = p99_str.find("ms");
-						if (ms_pos != std::string::npos) {
-							p99_str = p99_str.substr(0, ms_pos);
-							p99_str.erase(0, p99_str.find_first_not_of(" \t"));
-							p99_str.erase(p99_str.find_last_not_of(" \t") + 1);
-							perf.p99 = std::stoll(p99_str);
-						}
-						
-						ms_pos = max_str.find("ms");
-						if (ms_pos != std::string::npos) {
-							max_str = max_str.substr(0, ms_pos);
-							max_str.erase(0, max_str.find_first_not_of(" \t"));
-							max_str.erase(max_str.find_last_not_of(" \t") + 1);
-							perf.max = std::stoll(max_str);
-						}
-					}
-				}
-			}
-		}
+	// Single pass over the raw capture: escape codes, prompts and bot logging are skipped by the parser
+	const auto fields = ServerInfo::parse(result);
+	perf.revision = std::string(fields.revision.view());
+	perf.branch = std::string(fields.branch.view());
+	perf.build_date = std::string(fields.build_date.view());
+	perf.build_type = std::string(fields.build_type.view());
+	perf.connected_players = fields.connected_players;
+	perf.characters_in_world = fields.characters_in_world;
+	perf.connection_peak = fields.connection_peak;
+	perf.uptime = std::string(fields.uptime.view());
+	perf.uptime_seconds = fields.uptime_seconds;
+	perf.update_time_diff = fields.update_time_diff;
+	perf.mean = fields.mean;
+	perf.median = fields.median;
+	perf.p95 = fields.p95;
+	perf.p99 = fields.p99;
+	perf.max = fields.max;
 		
 		// Mark as available if we parsed at least one value
 		perf.available = (perf.update_time_diff > 0 || perf.mean > 0 || perf.median > 0);
@@ -791,13 +1734,13 @@ namespace AzerothCore {
 			
 			// Cache this good data (mark as fresh)
 			perf.is_cached = false;
-			last_known_perf = perf;
-			last_perf_update_time = now_ms;
+			last_perf_ = perf;
+			last_perf_ms_ = now_ms;
 		} else {
 			// Failed to parse - use cached data if available
-			if (last_known_perf.available) {
+			if (last_perf_.available) {
 				Logger::debug("fetch_server_performance: Parse failed, using last known good data");
-				perf = last_known_perf;
+				perf = last_perf_;
 				perf.available = true;  // Mark as available since we have cached data
 				perf.is_cached = true;  // Mark as cached
 			}
@@ -806,46 +1749,25 @@ namespace AzerothCore {
 		return perf;
 	}
 
+	void Query::forget_performance() {
+		last_perf_ = ServerPerformance();
+		last_perf_ms_ = 0;
+	}
+
 	std::vector<Continent> Query::fetch_continents() {
 		std::vector<Continent> continents;
 		
-		std::string query_str = 
-			"SELECT continent, SUM(count) as total_count FROM ( "
-			"  SELECT "
-			"    CASE map "
-			"      WHEN 0 THEN 'Eastern Kingdoms' "
-			"      WHEN 1 THEN 'Kalimdor' "
-			"      WHEN 530 THEN 'Outland' "
-			"      WHEN 571 THEN 'Northrend' "
-			"      WHEN 609 THEN 'Eastern Kingdoms' "
-			"      WHEN 30 THEN 'Battlegrounds' "
-			"      WHEN 489 THEN 'Battlegrounds' "
-			"      WHEN 529 THEN 'Battlegrounds' "
-			"      ELSE 'Instances' "
-			"    END as continent, "
-			"    COUNT(*) as count "
-			"  FROM characters "
-			"  WHERE online = 1 "
-			"    AND " + get_excluded_accounts_filter() + " "
-			"  GROUP BY map "
-			") as map_counts "
-			"GROUP BY continent "
-			"ORDER BY total_count DESC;";
-		
-		std::string result = mysql_exec(query_str);
+		std::string result = mysql_exec(sql_continents(), QueryPriority::NORMAL, COLLECTION_TTL_MS);
 		if (result.empty()) return continents;
 		
-		std::istringstream stream(result);
-		std::string line;
 		int total = 0;
 		
-		while (std::getline(stream, line)) {
-			size_t tab = line.find('\t');
-			if (tab == std::string::npos) continue;
+		for (const auto& row : Mysql::rows<std::string_view, int>(result)) {
+			if (!row) continue;
 			
 			Continent c;
-			c.name = line.substr(0, tab);
-			c.count = std::stoi(line.substr(tab + 1));
+			c.name = std::string(std::get<0>(*row));
+			c.count = std::get<1>(*row);
 			total += c.count;
 			continents.push_back(c);
 		}
@@ -855,42 +1777,25 @@ namespace AzerothCore {
 			if (total > 0) {
 				c.percent = (c.count * 100.0) / total;
 			}
-		}
-		
-		return continents;
-	}
-	
-	std::vector<Faction> Query::fetch_factions() {
-		std::vector<Faction> factions;
-		
-		std::string query_str = 
-			"SELECT "
-			"  CASE "
-			"    WHEN c.race IN (1,3,4,7,11) THEN 'Alliance' "
-			"    WHEN c.race IN (2,5,6,8,10) THEN 'Horde' "
-			"    ELSE 'Neutral' "
-			"  END as faction, "
-			"  COUNT(*) as count "
-			"FROM characters c "
-			"WHERE c.online = 1 "
-			"  AND " + get_excluded_accounts_filter() + " "
-			"GROUP BY faction "
-			"ORDER BY count DESC;";
+		}
+		
+		return continents;
+	}
+	
+	std::vector<Faction> Query::fetch_factions() {
+		std::vector<Faction> factions;
 		
-		std::string result = mysql_exec(query_str);
+		std::string result = mysql_exec(sql_factions(), QueryPriority::NORMAL, COLLECTION_TTL_MS);
 		if (result.empty()) return factions;
 		
-		std::istringstream stream(result);
-		std::string line;
 		int total = 0;
 		
-		while (std::getline(stream, line)) {
-			size_t tab = line.find('\t');
-			if (tab == std::string::npos) continue;
+		for (const auto& row : Mysql::rows<std::string_view, int>(result)) {
+			if (!row) continue;
 			
 			Faction f;
-			f.name = line.substr(0, tab);
-			f.count = std::stoi(line.substr(tab + 1));
+			f.name = std::string(std::get<0>(*row));
+			f.count = std::get<1>(*row);
 			total += f.count;
 			factions.push_back(f);
 		}
@@ -905,294 +1810,241 @@ namespace AzerothCore {
 		return factions;
 	}
 
-	std::vector<Zone> Query::fetch_zones() {
-		std::vector<Zone> zones;
-		
-		// Simplified query - just get zone IDs and stats from characters table
+	std::vector<Zone> Query::fetch_zones(LevelHistogram& all_levels, std::shared_ptr<const BotCube>& cube) {
+		// One fixed-shape histogram query per cycle, see sql_zone_histogram().
 		// Zone names come from hardcoded ZONE_NAMES map
-		std::string query_str = 
-			"SELECT "
-			"  zone as zone_id, "
-			"  COUNT(*) as total, "
-			"  MIN(level) as min_level, "
-			"  MAX(level) as max_level "
-			"FROM characters "
-			"WHERE online = 1 "
-			"  AND " + get_excluded_accounts_filter() + " "
-			"GROUP BY zone "
-			"HAVING total >= 1 "
-			"ORDER BY total DESC;";
-		
-		std::string result = mysql_exec(query_str);
+		std::string result = mysql_exec(sql_zone_histogram(), QueryPriority::NORMAL, COLLECTION_TTL_MS);
 		
 		if (result.empty()) {
 			Logger::debug("fetch_zones: mysql_exec returned empty result");
-			return zones;
+			return {};
 		}
 		
 		Logger::debug("fetch_zones: Got result with " + std::to_string(result.size()) + " bytes");
 		
-		std::istringstream stream(result);
-		std::string line;
+		std::unordered_map<int, LevelHistogram> histograms;
+		auto new_cube = std::make_shared<BotCube>();
 		int line_count = 0;
 		
-		while (std::getline(stream, line)) {
+		for (const auto& row : Mysql::rows<int, int, int, int, int>(result)) {
 			line_count++;
-			std::istringstream line_stream(line);
-			std::string zone_id_str, total_str, min_str, max_str;
-			
-			if (std::getline(line_stream, zone_id_str, '\t') &&
-				std::getline(line_stream, total_str, '\t') &&
-				std::getline(line_stream, min_str, '\t') &&
-				std::getline(line_stream, max_str)) {
-				
-				Zone z;
-				int zone_id = std::stoi(zone_id_str);
-				z.zone_id = zone_id;  // Store zone ID for detail queries
-				z.name = AzerothCore::get_zone_name(zone_id);  // Use hardcoded zone name map
-				
-				// Get continent and region metadata
-				auto metadata = AzerothCore::get_zone_metadata(zone_id);
-				z.continent = metadata.continent;
-				z.region = metadata.region;
-				
-				z.total = std::stoi(total_str);
-				
-			// Store expected levels from metadata
-			z.expected_min = metadata.min_level;
-			z.expected_max = metadata.max_level;
-			
-			// Store actual bot levels from database
-			z.actual_min = std::stoi(min_str);
-			z.actual_max = std::stoi(max_str);
-			
-			// Calculate proper alignment based on actual bot count within expected range
-			z.alignment = 0.0;
-			if (z.expected_min > 0 && z.expected_max > 0 && z.total > 0) {
-				// Query to count bots within the expected level range for this zone
-				std::string count_query = 
-					"SELECT COUNT(*) "
-					"FROM characters "
-					"WHERE online = 1 "
-					"  AND zone = " + zone_id_str + " "
-					"  AND level >= " + std::to_string(z.expected_min) + " "
-					"  AND level <= " + std::to_string(z.expected_max) + " "
-					"  AND " + get_excluded_accounts_filter() + ";";
-				
-				std::string count_result = mysql_exec(count_query);
-				if (!count_result.empty()) {
-					try {
-						int bots_in_range = std::stoi(count_result);
-						// Alignment percentage = (bots in correct range / total bots) * 100
-						z.alignment = (bots_in_range * 100.0) / z.total;
-					} catch (...) {
-						// Parse error, fall back to 0
-						z.alignment = 0.0;
-					}
-				} else {
-					z.alignment = 0.0;
-				}
-			} else {
-				// Unknown zones or zones without metadata
-				z.alignment = 0.0;
-			}
-			
-			zones.push_back(z);
-				Logger::debug("fetch_zones: Parsed zone '" + z.name + "' (ID: " + zone_id_str + ") with " + std::to_string(z.total) + " bots");
-			} else {
-				Logger::debug("fetch_zones: Failed to parse line " + std::to_string(line_count) + ": '" + line + "'");
+			if (!row) {
+				Logger::debug("fetch_zones: Failed to parse line " + std::to_string(line_count));
+				continue;
 			}
+			auto [zone_id, level, race, class_id, count] = *row;
+			const int faction = race_faction(race);
+			histograms[zone_id].add(level, count, faction == 0 ? count : 0, faction == 1 ? count : 0);
+			new_cube->add(zone_id, level, race, class_id, count);
 		}
+		new_cube->finalize();
+		cube = std::move(new_cube);
 		
-	Logger::debug("fetch_zones: Successfully parsed " + std::to_string(zones.size()) + " zones from " + std::to_string(line_count) + " lines");
-	
-	// Sort zones hierarchically: by continent, then region, then total descending
-	std::sort(zones.begin(), zones.end(), [](const Zone& a, const Zone& b) {
-		bool a_unknown = a.continent == "Unknown";
-		bool b_unknown = b.continent == "Unknown";
-		
-		// Unknown zones go to the bottom
-		if (a_unknown != b_unknown) {
-			return !a_unknown;
-		}
-		
-		// Sort by continent
-		if (a.continent != b.continent) {
-			// Order: Eastern Kingdoms, Kalimdor, Outland, Northrend, Unknown
-			const std::vector<std::string> continent_order = {"Eastern Kingdoms", "Kalimdor", "Outland", "Northrend"};
-			auto a_it = std::find(continent_order.begin(), continent_order.end(), a.continent);
-			auto b_it = std::find(continent_order.begin(), continent_order.end(), b.continent);
-			
-			if (a_it != continent_order.end() && b_it != continent_order.end()) {
-				return a_it < b_it;
+		Logger::debug("fetch_zones: " + std::to_string(line_count) + " histogram rows");
+		return build_zones(histograms, all_levels);
+	}
+
+	void LevelHistogram::add(int level, int total, int alliance, int horde) {
+		totals_[ALL] += total;
+		totals_[ALLIANCE] += alliance;
+		totals_[HORDE] += horde;
+		if (total > 0) {
+			if (min_level_ == 0 || level < min_level_) min_level_ = level;
+			if (level > max_level_) max_level_ = level;
+		}
+		if (level < 1 || level > MAX_LEVEL) return;
+		sums_[ALL][level] += total;
+		sums_[ALLIANCE][level] += alliance;
+		sums_[HORDE][level] += horde;
+	}
+
+	void LevelHistogram::merge(const LevelHistogram& other) {
+		// Differences of the prefix sums give back the per-level counts
+		for (int side : {ALL, ALLIANCE, HORDE}) {
+			for (int level = 1; level <= MAX_LEVEL; level++) {
+				int n = other.sums_[side][level];
+				if (other.finalized_) n -= other.sums_[side][level - 1];
+				sums_[side][level] += n;
 			}
-			return a.continent < b.continent;
+			totals_[side] += other.totals_[side];
 		}
-		
-		// Same continent: sort by region
-		if (a.region != b.region) {
-			return a.region < b.region;
+		if (other.totals_[ALL] > 0) {
+			if (min_level_ == 0 || other.min_level_ < min_level_) min_level_ = other.min_level_;
+			max_level_ = std::max(max_level_, other.max_level_);
 		}
-		
-		// Same continent and region: sort by total descending
-		return a.total > b.total;
-	});
-	
-	return zones;
 	}
 
-	std::vector<LevelBracket> Query::fetch_levels() {
-		std::vector<LevelBracket> levels;
-		
-		// Build dynamic SQL CASE statement based on loaded bracket definitions
-		std::string case_statement = "  CASE ";
-		for (const auto& bracket : expected_values.bracket_definitions) {
-			case_statement += "\n    WHEN level BETWEEN " + std::to_string(bracket.min_level) + 
-			                  " AND " + std::to_string(bracket.max_level) + 
-			                  " THEN '" + bracket.range + "' ";
+	void LevelHistogram::finalize() {
+		if (finalized_) return;
+		for (auto& sums : sums_) {
+			std::partial_sum(sums.begin(), sums.end(), sums.begin());
 		}
-		case_statement += "\n    ELSE 'Other' ";
-		case_statement += "\n  END as bracket";
-		
-		std::string query_str = 
-			"SELECT " + case_statement + ", "
-			"  COUNT(*) as count "
-			"FROM characters "
-			"WHERE online = 1 "
-			"  AND " + get_excluded_accounts_filter() + " "
-			"GROUP BY bracket "
-			"ORDER BY MIN(level);";
-		
-		std::string result = mysql_exec(query_str);
-		if (result.empty()) return levels;
-		
-		std::istringstream stream(result);
-		std::string line;
-		int total = 0;
+		finalized_ = true;
+	}
+
+	int LevelHistogram::count(int min_level, int max_level, Side side) const {
+		min_level = std::max(min_level, 1);
+		max_level = std::min(max_level, MAX_LEVEL);
+		if (not finalized_ || min_level > max_level) return 0;
+		return sums_[side][max_level] - sums_[side][min_level - 1];
+	}
+
+	void BotCube::add(int zone_id, int level, int race, int class_id, int count) {
+		if (level < 1 || level > MAX_LEVEL || race < 1 || race > RACES || class_id < 1 || class_id > CLASSES) return;
+		auto [it, inserted] = zone_index_.try_emplace(zone_id, zone_ids_.size());
+		if (inserted) {
+			zone_ids_.push_back(zone_id);
+			counts_.resize(counts_.size() + (size_t)RACES * CLASSES * (MAX_LEVEL + 1), 0);
+		}
+		counts_[cell(it->second, race, class_id) + level] += count;
+		total_ += count;
+	}
+
+	void BotCube::finalize() {
+		if (finalized_) return;
+		for (size_t start = 0; start < counts_.size(); start += MAX_LEVEL + 1) {
+			std::partial_sum(counts_.begin() + start, counts_.begin() + start + MAX_LEVEL + 1, counts_.begin() + start);
+		}
+		finalized_ = true;
+	}
+
+	int BotCube::count(size_t zone, int race, int class_id, int min_level, int max_level) const {
+		min_level = std::max(min_level, 1);
+		max_level = std::min(max_level, MAX_LEVEL);
+		if (not finalized_ || zone >= zone_ids_.size() || min_level > max_level) return 0;
+		const size_t base = cell(zone, race, class_id);
+		return counts_[base + max_level] - counts_[base + min_level - 1];
+	}
+
+	std::vector<LevelBracket> rebin(const LevelHistogram& histogram, const std::vector<BracketDefinition>& brackets,
+		LevelHistogram::Side side) {
+		std::vector<LevelBracket> levels;
+		levels.reserve(brackets.size() + 1);
 		
-		while (std::getline(stream, line)) {
-			size_t tab = line.find('\t');
-			if (tab == std::string::npos) continue;
-			
+		const int all = histogram.total();
+		int binned = 0;
+		for (const auto& bracket : brackets) {
 			LevelBracket lb;
-			lb.range = line.substr(0, tab);
-			lb.count = std::stoi(line.substr(tab + 1));
-			total += lb.count;
+			lb.range = bracket.range;
+			lb.count = histogram.count(bracket.min_level, bracket.max_level, side);
+			binned += lb.count;
 			levels.push_back(lb);
 		}
 		
-		// Calculate percentages
+		int other = histogram.total(side) - binned;
+		if (other > 0) levels.push_back({"Other", other, 0.0});
+		
 		for (auto& lb : levels) {
-			if (total > 0) {
-				lb.percent = (lb.count * 100.0) / total;
-			}
+			if (all > 0) lb.percent = (lb.count * 100.0) / all;
 		}
 		
 		return levels;
 	}
-	
-	std::vector<ZoneDetail> Query::fetch_zone_details(int zone_id) {
-	std::vector<ZoneDetail> details;
-	
-	// Write debug info to file for easy checking
-	std::ofstream debug_file("/tmp/bottop_zone_debug.txt", std::ios::app);
-	debug_file << "\n=== fetch_zone_details called ===" << std::endl;
-	debug_file << "zone_id: " << zone_id << std::endl;
-	
-	Logger::debug("fetch_zone_details: Fetching level breakdown for zone_id=" + std::to_string(zone_id));
-	
-	// Query level distribution with faction splits
-	std::string query_str = 
-		"SELECT "
-		"  CASE "
-		"    WHEN c.level BETWEEN 1 AND 9 THEN '1-9' "
-		"    WHEN c.level BETWEEN 10 AND 19 THEN '10-19' "
-		"    WHEN c.level BETWEEN 20 AND 29 THEN '20-29' "
-		"    WHEN c.level BETWEEN 30 AND 39 THEN '30-39' "
-		"    WHEN c.level BETWEEN 40 AND 49 THEN '40-49' "
-		"    WHEN c.level BETWEEN 50 AND 59 THEN '50-59' "
-		"    WHEN c.level BETWEEN 60 AND 69 THEN '60-69' "
-		"    WHEN c.level BETWEEN 70 AND 79 THEN '70-79' "
-		"    WHEN c.level = 80 THEN '80' "
-		"    ELSE 'Other' "
-		"  END as bracket, "
-		"  COUNT(*) as total, "
-		"  SUM(CASE WHEN c.race IN (1,3,4,7,11) THEN 1 ELSE 0 END) as alliance_count, "
-		"  SUM(CASE WHEN c.race IN (2,5,6,8,10) THEN 1 ELSE 0 END) as horde_count "
-		"FROM characters c "
-		"WHERE c.online = 1 AND c.zone = " + std::to_string(zone_id) + " "
-		"  AND " + get_excluded_accounts_filter() + " "
-		"GROUP BY bracket "
-		"ORDER BY MIN(c.level);";
-	
-	debug_file << "Query: " << query_str << std::endl;
-	
-	std::string result = mysql_exec(query_str);
-	
-	debug_file << "Result length: " << result.size() << " bytes" << std::endl;
-	debug_file << "Result content: [" << result << "]" << std::endl;
-	
-	if (result.empty()) {
-		Logger::debug("fetch_zone_details: Empty result for zone " + std::to_string(zone_id));
-		debug_file << "Empty result - returning empty details" << std::endl;
-		debug_file.close();
-		return details;
-	}
-	
-	std::istringstream stream(result);
-	std::string line;
-	int line_num = 0;
-	
-	while (std::getline(stream, line)) {
-		line_num++;
-		debug_file << "Line " << line_num << ": [" << line << "]" << std::endl;
-		
-		std::istringstream line_stream(line);
-		std::string bracket, total_str, alliance_str, horde_str;
-		
-		if (!std::getline(line_stream, bracket, '\t')) {
-			debug_file << "  Failed to read bracket" << std::endl;
-			continue;
-		}
-		if (!std::getline(line_stream, total_str, '\t')) {
-			debug_file << "  Failed to read total (bracket=" << bracket << ")" << std::endl;
-			continue;
-		}
-		if (!std::getline(line_stream, alliance_str, '\t')) {
-			debug_file << "  Failed to read alliance (bracket=" << bracket << ", total=" << total_str << ")" << std::endl;
-			continue;
+
+	std::vector<LevelBracket> level_brackets(const LevelHistogram& histogram) {
+		const auto& alliance = expected_values.bracket_definitions;
+		const auto& horde = expected_values.horde_bracket_definitions;
+		if (horde.empty()) return rebin(histogram, alliance);
+		
+		// Separate layouts: bin each faction by its own brackets and add up brackets with the same range
+		auto levels = rebin(histogram, alliance, LevelHistogram::ALLIANCE);
+		for (const auto& lb : rebin(histogram, horde, LevelHistogram::HORDE)) {
+			auto it = std::find_if(levels.begin(), levels.end(), [&](const LevelBracket& l) { return l.range == lb.range; });
+			if (it != levels.end()) {
+				it->count += lb.count;
+				it->percent += lb.percent;
+			}
+			else levels.push_back(lb);
 		}
-		if (!std::getline(line_stream, horde_str, '\t')) {
-			debug_file << "  Failed to read horde (bracket=" << bracket << ", total=" << total_str << ", alliance=" << alliance_str << ")" << std::endl;
-			continue;
+		return levels;
+	}
+
+	void rebin_current() {
+		current_data.levels = level_brackets(current_data.level_histogram);
+		sample_levels(current_data.levels, current_data.sample);
+	}
+
+	Pivot pivot(const BotCube& cube, PivotView view, const ExpectedValues& expected, double scale) {
+		static const std::array<std::pair<int, const char*>, 10> classes = {{
+			{1, "War"}, {2, "Pal"}, {3, "Hun"}, {4, "Rog"}, {5, "Pri"}, {6, "DK"}, {7, "Sha"}, {8, "Mag"}, {9, "Lck"}, {11, "Dru"}
+		}};
+		static const std::array<std::pair<int, const char*>, 10> races = {{
+			{1, "Hum"}, {2, "Orc"}, {3, "Dwa"}, {4, "NE"}, {5, "UD"}, {6, "Tau"}, {7, "Gno"}, {8, "Trl"}, {10, "BE"}, {11, "Dra"}
+		}};
+		const auto& zones = cube.zones();
+		Pivot result;
+		
+		switch (view) {
+			case PivotView::CLASS_BY_ZONE:
+				result.title = "Class mix per zone";
+				for (const auto& [id, label] : classes) result.columns.push_back(label);
+				for (size_t z = 0; z < zones.size(); z++) {
+					Pivot::Row row{get_zone_name(zones[z]), std::vector<int>(classes.size(), 0)};
+					for (int race = 1; race <= BotCube::RACES; race++) {
+						for (size_t c = 0; c < classes.size(); c++) row.cells[c] += cube.count(z, race, classes[c].first);
+					}
+					result.rows.push_back(std::move(row));
+				}
+				break;
+			case PivotView::RACE_BY_BRACKET: {
+				result.title = "Race mix per level bracket";
+				for (const auto& [id, label] : races) result.columns.push_back(label);
+				// With separate layouts Horde races are binned by the Horde brackets, a range both have is one row
+				const bool split = !expected.horde_bracket_definitions.empty();
+				std::vector<int> starts;  // First level of each row, rows are kept in level order
+				auto add_brackets = [&](const std::vector<BracketDefinition>& brackets, int faction) {
+					for (const auto& bracket : brackets) {
+						const std::string row_label = "Lvl " + bracket.range;
+						auto it = std::find_if(result.rows.begin(), result.rows.end(), [&](const Pivot::Row& row) { return row.label == row_label; });
+						if (it == result.rows.end()) {
+							const auto at = std::upper_bound(starts.begin(), starts.end(), bracket.min_level) - starts.begin();
+							starts.insert(starts.begin() + at, bracket.min_level);
+							it = result.rows.insert(result.rows.begin() + at, Pivot::Row{row_label, std::vector<int>(races.size(), 0)});
+						}
+						for (size_t z = 0; z < zones.size(); z++) {
+							for (size_t r = 0; r < races.size(); r++) {
+								if (split && race_faction(races[r].first) != faction) continue;
+								for (const auto& [class_id, label] : classes) {
+									it->cells[r] += cube.count(z, races[r].first, class_id, bracket.min_level, bracket.max_level);
+								}
+							}
+						}
+					}
+				};
+				add_brackets(expected.bracket_definitions, 0);
+				if (split) add_brackets(expected.horde_bracket_definitions, 1);
+				break;
+			}
+			case PivotView::FACTION_BY_CONTINENT: {
+				result.title = "Faction split per continent";
+				result.columns = {"Ally", "Horde"};
+				std::map<std::string, Pivot::Row> continents;
+				for (size_t z = 0; z < zones.size(); z++) {
+					const std::string continent = get_zone_metadata(zones[z]).continent;
+					auto& row = continents.try_emplace(continent, Pivot::Row{continent, std::vector<int>(2, 0)}).first->second;
+					for (int race = 1; race <= BotCube::RACES; race++) {
+						const int faction = race_faction(race);
+						if (faction > 1) continue;
+						for (const auto& [class_id, label] : classes) row.cells[faction] += cube.count(z, race, class_id);
+					}
+				}
+				for (auto& [name, row] : continents) result.rows.push_back(std::move(row));
+				break;
+			}
 		}
 		
-		try {
-			ZoneDetail d;
-			int total = std::stoi(total_str);
-			int alliance = std::stoi(alliance_str);
-			int horde = std::stoi(horde_str);
-			
-			// Format: "Lvl 1-9: 45 bots (12A/33H)"
-			d.label = "  Lvl " + bracket + ": " + std::to_string(total) + " bots (" +
-			          std::to_string(alliance) + "A/" + std::to_string(horde) + "H)";
-			d.count = total;
-			d.percent = 0.0;
-			
-			debug_file << "  Parsed: " << d.label << std::endl;
-			details.push_back(d);
-		} catch (const std::exception& e) {
-			debug_file << "  Parse exception: " << e.what() << std::endl;
-			Logger::error("Failed to parse zone detail line: " + std::string(e.what()));
-			continue;
+		for (auto& row : result.rows) {
+			for (auto& cell : row.cells) {
+				if (scale != 1.0) cell = (int)std::lround(cell * scale);
+				row.total += cell;
+			}
 		}
-	}
-	
-	debug_file << "Total details parsed: " << details.size() << std::endl;
-	debug_file.close();
-	
-	Logger::debug("fetch_zone_details: Returning " + std::to_string(details.size()) + " level brackets for zone " + std::to_string(zone_id));
-	return details;
+		std::erase_if(result.rows, [](const Pivot::Row& row) { return row.total == 0; });
+		// Brackets keep their level order, zones and continents go largest first
+		if (view != PivotView::RACE_BY_BRACKET) {
+			std::stable_sort(result.rows.begin(), result.rows.end(), [](const Pivot::Row& a, const Pivot::Row& b) { return a.total > b.total; });
+		}
+		return result;
 	}
 	
 	OllamaStats Query::fetch_ollama_stats() {
@@ -1205,7 +2057,7 @@ namespace AzerothCore {
 			"AND table_name LIKE 'mod_ollama%' "
 			"ORDER BY table_name;";
 		
-		std::string search_result = mysql_exec(search_query);
+		std::string search_result = mysql_exec(search_query, QueryPriority::LOW);
 		Logger::debug("fetch_ollama_stats: Found mod_ollama tables: '" + search_result + "'");
 		
 		// Priority order: look for log/history tables first, then stats, then personality
@@ -1220,34 +2072,24 @@ namespace AzerothCore {
 		};
 		
 		std::string found_table;
-		std::istringstream stream(search_result);
-		std::string line;
+		std::vector<std::string_view> tables;
+		for (const auto& row : Mysql::rows<std::string_view>(search_result)) {
+			if (row && std::get<0>(*row) != "table_name") tables.push_back(std::get<0>(*row));
+		}
 		
 		// First pass: check priority tables
-		while (std::getline(stream, line)) {
-			if (!line.empty() && line != "table_name") {
-				for (const auto& priority_table : table_priority) {
-					if (line == priority_table) {
-						found_table = line;
-						Logger::debug("fetch_ollama_stats: Using priority table: '" + line + "'");
-						break;
-					}
-				}
-				if (!found_table.empty()) break;
+		for (const auto& priority_table : table_priority) {
+			if (std::find(tables.begin(), tables.end(), priority_table) != tables.end()) {
+				found_table = priority_table;
+				Logger::debug("fetch_ollama_stats: Using priority table: '" + found_table + "'");
+				break;
 			}
 		}
 		
 		// Second pass: if no priority match, use first found table
-		if (found_table.empty()) {
-			stream.clear();
-			stream.seekg(0);
-			while (std::getline(stream, line)) {
-				if (!line.empty() && line != "table_name") {
-					found_table = line;
-					Logger::debug("fetch_ollama_stats: Using first available table: '" + line + "'");
-					break;
-				}
-			}
+		if (found_table.empty() && !tables.empty()) {
+			found_table = std::string(tables.front());
+			Logger::debug("fetch_ollama_stats: Using first available table: '" + found_table + "'");
 		}
 		
 		if (found_table.empty()) {
@@ -1266,20 +2108,17 @@ namespace AzerothCore {
 		stats_query = "SELECT COUNT(DISTINCT guid) FROM " + found_table + ";";
 		Logger::debug("fetch_ollama_stats: Counting characters with Ollama personalities");
 		
-		std::string result = mysql_exec(stats_query);
+		std::string result = mysql_exec(stats_query, QueryPriority::LOW);
 		Logger::debug("fetch_ollama_stats: Query result: '" + result + "'");
 		
-		if (!result.empty()) {
-			try {
-				int total_count = std::stoi(result);
-				// For personality table, just show character count as "rate"
-				ollama.messages_per_hour = total_count;
-				ollama.recent_messages = 0;  // No recent activity data
-				ollama.failure_rate_60s = 0.0;
-				Logger::debug("fetch_ollama_stats: " + std::to_string(total_count) + " characters with Ollama");
-			} catch (const std::exception& e) {
-				Logger::debug("fetch_ollama_stats: Error parsing count: " + std::string(e.what()));
-			}
+		if (auto total_count = Mysql::scalar<int>(result)) {
+			// For personality table, just show character count as "rate"
+			ollama.messages_per_hour = *total_count;
+			ollama.recent_messages = 0;  // No recent activity data
+			ollama.failure_rate_60s = 0.0;
+			Logger::debug("fetch_ollama_stats: " + std::to_string(*total_count) + " characters with Ollama");
+		} else {
+			Logger::debug("fetch_ollama_stats: Error parsing count");
 		}
 		} else {
 			// Log/history/stats table - query for three specific metrics:
@@ -1295,24 +2134,23 @@ namespace AzerothCore {
 				"AND (COLUMN_NAME LIKE '%time%' OR COLUMN_NAME LIKE '%date%') "
 				"LIMIT 1;";
 			
-		std::string timestamp_col = mysql_exec(column_query);
-		Logger::debug("fetch_ollama_stats: Timestamp column search result: '" + timestamp_col + "'");
+		std::string column_result = mysql_exec(column_query, QueryPriority::LOW);
+		Logger::debug("fetch_ollama_stats: Timestamp column search result: '" + column_result + "'");
+		std::string timestamp_col(Mysql::scalar<std::string_view>(column_result).value_or(""));
 		
 		if (!timestamp_col.empty()) {
-			// Remove newlines/whitespace
-			timestamp_col.erase(timestamp_col.find_last_not_of(" \n\r\t") + 1);
 			Logger::debug("fetch_ollama_stats: Using timestamp column: '" + timestamp_col + "'");
 			
 			// Query 1: Messages in last 60 minutes (for hourly rate)
 			std::string hour_query = "SELECT COUNT(*) FROM " + found_table + 
 				" WHERE " + timestamp_col + " >= NOW() - INTERVAL 60 MINUTE;";
-			std::string hour_result = mysql_exec(hour_query);
+			std::string hour_result = mysql_exec(hour_query, QueryPriority::LOW);
 			Logger::debug("fetch_ollama_stats: Hour query result: '" + hour_result + "'");
 			
 			// Query 2: Messages in last 60 seconds (recent activity)
 			std::string recent_query = "SELECT COUNT(*) FROM " + found_table + 
 				" WHERE " + timestamp_col + " >= NOW() - INTERVAL 60 SECOND;";
-			std::string recent_result = mysql_exec(recent_query);
+			std::string recent_result = mysql_exec(recent_query, QueryPriority::LOW);
 			Logger::debug("fetch_ollama_stats: Recent (60s) query result: '" + recent_result + "'");
 				
 				// Query 3: Check if table has a success/status column for failure rate
@@ -1322,28 +2160,27 @@ namespace AzerothCore {
 					"AND TABLE_NAME = '" + found_table + "' "
 					"AND (COLUMN_NAME LIKE '%success%' OR COLUMN_NAME LIKE '%status%' OR COLUMN_NAME LIKE '%error%' OR COLUMN_NAME LIKE '%fail%') "
 					"LIMIT 1;";
-				std::string status_col = mysql_exec(status_col_query);
+				std::string status_col(Mysql::scalar<std::string_view>(mysql_exec(status_col_query, QueryPriority::LOW)).value_or(""));
 				
 				double failure_rate = 0.0;
 				
 				if (!status_col.empty()) {
 					// Has status column - query actual failure rate for last 60 seconds
-					status_col.erase(status_col.find_last_not_of(" \n\r\t") + 1);
 					
 					// Try to count failures (assuming status=0 or success=false or error=1)
 					std::string failure_query = "SELECT COUNT(*) FROM " + found_table + 
 						" WHERE " + timestamp_col + " >= NOW() - INTERVAL 60 SECOND "
 						"AND (" + status_col + " = 0 OR " + status_col + " = false OR " + status_col + " IS NULL);";
-					std::string failure_result = mysql_exec(failure_query);
+					std::string failure_result = mysql_exec(failure_query, QueryPriority::LOW);
 					
 					if (!failure_result.empty() && !recent_result.empty()) {
-						try {
-							int failures = std::stoi(failure_result);
-							int recent_total = std::stoi(recent_result);
-							if (recent_total > 0) {
-								failure_rate = (failures * 100.0) / recent_total;
+						auto failures = Mysql::scalar<int>(failure_result);
+						auto recent_total = Mysql::scalar<int>(recent_result);
+						if (failures && recent_total) {
+							if (*recent_total > 0) {
+								failure_rate = (*failures * 100.0) / *recent_total;
 							}
-						} catch (...) {
+						} else {
 							// Assume 5% failure rate if we can't parse
 							failure_rate = 5.0;
 						}
@@ -1353,21 +2190,18 @@ namespace AzerothCore {
 					failure_rate = 5.0;
 				}
 				
-				if (!hour_result.empty() && !recent_result.empty()) {
-					try {
-						int hour_count = std::stoi(hour_result);
-						int recent_count = std::stoi(recent_result);
-						
-						ollama.messages_per_hour = hour_count;
-						ollama.recent_messages = recent_count;
-						ollama.failure_rate_60s = failure_rate;
-						
-						Logger::debug("fetch_ollama_stats: rate=" + std::to_string(hour_count) + 
-							" msgs/hr, recent=" + std::to_string(recent_count) + 
-							" msgs (60s), failure=" + std::to_string(failure_rate) + "%");
-					} catch (const std::exception& e) {
-						Logger::debug("fetch_ollama_stats: Error parsing counts: " + std::string(e.what()));
-					}
+				auto hour_count = Mysql::scalar<int>(hour_result);
+				auto recent_count = Mysql::scalar<int>(recent_result);
+				if (hour_count && recent_count) {
+					ollama.messages_per_hour = *hour_count;
+					ollama.recent_messages = *recent_count;
+					ollama.failure_rate_60s = failure_rate;
+					
+					Logger::debug("fetch_ollama_stats: rate=" + std::to_string(*hour_count) + 
+						" msgs/hr, recent=" + std::to_string(*recent_count) + 
+						" msgs (60s), failure=" + std::to_string(failure_rate) + "%");
+				} else {
+					Logger::debug("fetch_ollama_stats: Error parsing counts");
 				}
 			} else {
 				// No timestamp column - can't provide time-based metrics
@@ -1396,7 +2230,7 @@ namespace AzerothCore {
 			std::string check_cmd = "docker exec " + config_.container + 
 			                       " cat /tmp/azerothcore_rebuild_progress.txt 2>/dev/null || echo 'none'";
 			
-			std::string result = executor_.execute(check_cmd);
+			std::string result = executor_.execute(check_cmd, cancel_);
 			
 			// Trim whitespace
 			result.erase(0, result.find_first_not_of(" \t\n\r"));
@@ -1439,7 +2273,7 @@ namespace AzerothCore {
 			//   testing-ac-database|running|Up 2 hours
 			
 			std::string cmd = "docker ps -a --filter 'name=ac-' --format '{{.Names}}|{{.State}}|{{.Status}}'";
-			std::string result = executor_.execute(cmd);
+			std::string result = executor_.execute_cached(cmd, CONTAINERS_TTL_MS, cancel_, refresh_);
 			
 			if (result.empty()) {
 				Logger::debug("fetch_container_statuses: No containers found");
@@ -1494,14 +2328,13 @@ namespace AzerothCore {
 		
 		return containers;
 	}
-
-	ServerData Query::fetch_all() {
+	ServerData Query::fetch_all(bool full, bool exact) {
 		ServerData data;
 		
 		Logger::error("FETCH_ALL DEBUG: Starting fetch_all()");
 		
 		// Set server URL from config
-		data.server_url = config.ssh_host;
+		data.server_url = config_.ssh_host;
 		
 		// Get current timestamp
 		auto now = std::time(nullptr);
@@ -1511,9 +2344,34 @@ namespace AzerothCore {
 		
 		try {
 			Logger::error("FETCH_ALL DEBUG: About to call fetch_bot_stats()");
-			data.stats = fetch_bot_stats();
+			data.stats = fetch_bot_stats(false);
+			
+			// A fresh server-maintained summary replaces the bot count and every distribution query
+			if (time_ms() >= next_summary_check_) detect_summary();
+			const bool verify_due = time_ms() >= next_summary_verify_;
+			bool counted = false;
+			summary_.active = summary_ready_ && (!summary_drifted_ || verify_due) && fetch_summary(data);
+			if (summary_.active && verify_due) {
+				summary_.active = verify_summary(data.stats);
+				counted = true;
+			}
+			data.summary = summary_;
+			if (summary_.active) {
+				plan_sample(data.stats.total, true);
+				if (!data.level_histogram.empty()) data.levels = level_brackets(data.level_histogram);
+				apply_sample(data);
+				if (full) data.ollama = fetch_ollama_stats();
+				return data;
+			}
+			
+			if (!counted) count_bots(data.stats);
 			Logger::error("FETCH_ALL DEBUG: fetch_bot_stats() returned, total=" + std::to_string(data.stats.total));
 			
+			if (!full) return data;
+			
+			// The exact bot count sizes the sample for the distribution queries below
+			plan_sample(data.stats.total, exact);
+			
 			Logger::error("FETCH_ALL DEBUG: About to call fetch_continents()");
 			data.continents = fetch_continents();
 			Logger::error("FETCH_ALL DEBUG: fetch_continents() returned");
@@ -1523,27 +2381,572 @@ namespace AzerothCore {
 			Logger::error("FETCH_ALL DEBUG: fetch_factions() returned");
 			
 			Logger::error("FETCH_ALL DEBUG: About to call fetch_zones()");
-			data.zones = fetch_zones();
+			data.zones = fetch_zones(data.level_histogram, data.cube);
 			Logger::error("FETCH_ALL DEBUG: fetch_zones() returned, count=" + std::to_string(data.zones.size()));
 			
-			Logger::error("FETCH_ALL DEBUG: About to call fetch_levels()");
-			data.levels = fetch_levels();
-			Logger::error("FETCH_ALL DEBUG: fetch_levels() returned");
+			if (!data.level_histogram.empty()) data.levels = level_brackets(data.level_histogram);
+			apply_sample(data);
+			
+			Logger::error("FETCH_ALL DEBUG: About to call fetch_ollama_stats()");
+			data.ollama = fetch_ollama_stats();
+			Logger::error("FETCH_ALL DEBUG: fetch_ollama_stats() returned");
+		} catch (const std::exception& e) {
+			Logger::error("FETCH_ALL DEBUG: Exception caught: " + std::string(e.what()));
+			data.error = e.what();
+		}
+		
+		Logger::error("FETCH_ALL DEBUG: Returning from fetch_all()");
+		return data;
+	}
+
+	std::vector<BotRow> Query::fetch_zone_bots(int zone_id, int expected_min, int expected_max, int after_guid, int limit) {
+		std::vector<BotRow> bots;
+		
+		// Keyset on the primary key instead of OFFSET or a computed sort key, so each page reads
+		// about limit rows of the zone however deep the list is scrolled
+		std::string result = mysql_exec(
+			"SELECT guid, name, level, class, race, account FROM characters "
+			"WHERE online = 1 "
+			"  AND zone = " + std::to_string(zone_id) + " "
+			"  AND guid > " + std::to_string(after_guid) + " "
+			"  AND " + get_excluded_accounts_filter() + " "
+			"ORDER BY guid "
+			"LIMIT " + std::to_string(limit) + ";",
+			QueryPriority::CRITICAL);
+		
+		// Levels outside the expected range, zones without a known range have none
+		const bool ranged = expected_min > 0 && expected_max > 0;
+		for (const auto& row : Mysql::rows<int, std::string_view, int, int, int, int>(result)) {
+			if (!row) continue;
+			auto [guid, name, level, class_id, race, account] = *row;
+			BotRow bot;
+			bot.guid = guid;
+			bot.name = std::string(name);
+			bot.level = level;
+			bot.class_id = class_id;
+			bot.race = race;
+			bot.account = account;
+			if (ranged && level < expected_min) bot.deviation = level - expected_min;
+			else if (ranged && level > expected_max) bot.deviation = level - expected_max;
+			bots.push_back(std::move(bot));
+		}
+		std::stable_sort(bots.begin(), bots.end(), [](const BotRow& a, const BotRow& b) { return std::abs(a.deviation) > std::abs(b.deviation); });
+		Logger::debug("fetch_zone_bots: zone " + std::to_string(zone_id) + " page of " + std::to_string(bots.size()));
+		return bots;
+	}
+
+	std::optional<std::vector<Names::Position>> Query::fetch_online_positions() {
+		std::string result = mysql_exec(
+			"SELECT guid, zone, level FROM characters "
+			"WHERE online = 1 AND " + get_excluded_accounts_filter() + ";");
+		if (result.empty()) return std::nullopt;
+		
+		std::vector<Names::Position> positions;
+		for (const auto& row : Mysql::rows<int, int, int>(result)) {
+			if (!row) continue;
+			auto [guid, zone, level] = *row;
+			positions.push_back({guid, zone, level});
+		}
+		return positions;
+	}
+
+	std::unordered_map<int, std::string> Query::fetch_names(const std::vector<int>& guids) {
+		std::unordered_map<int, std::string> names;
+		if (guids.empty()) return names;
+		
+		// Primary key lookups for the few bots that logged in since the last cycle,
+		// the first cycle after startup needs nearly every name and reads them in one go
+		std::string lookup;
+		if (guids.size() > NAME_BATCH) {
+			lookup = "SELECT guid, name FROM characters WHERE online = 1 AND " + get_excluded_accounts_filter() + ";";
+		} else {
+			std::string list;
+			for (int guid : guids) list += (list.empty() ? "" : ",") + std::to_string(guid);
+			lookup = "SELECT guid, name FROM characters WHERE guid IN (" + list + ");";
+		}
+		
+		std::string result = mysql_exec(lookup);
+		for (const auto& row : Mysql::rows<int, std::string_view>(result)) {
+			if (!row) continue;
+			auto [guid, name] = *row;
+			names.emplace(guid, std::string(name));
+		}
+		return names;
+	}
+
+	std::vector<TableSize> Query::fetch_table_sizes() {
+		// MySQL 8 answers from cached statistics that expire once a day by default, ask for current ones.
+		// The version comment keeps older servers from rejecting the unknown variable.
+		std::string result = mysql_exec(
+			"/*!80000 SET SESSION information_schema_stats_expiry = 0 */; "
+			"SELECT TABLE_NAME, IFNULL(TABLE_ROWS, 0), IFNULL(DATA_LENGTH, 0), IFNULL(INDEX_LENGTH, 0) "
+			"FROM information_schema.TABLES "
+			"WHERE TABLE_SCHEMA = DATABASE() AND TABLE_TYPE = 'BASE TABLE';",
+			QueryPriority::LOW);
+		
+		std::vector<TableSize> sizes;
+		for (const auto& row : Mysql::rows<std::string_view, int64_t, uint64_t, uint64_t>(result)) {
+			if (!row) continue;
+			auto [name, rows, data_bytes, index_bytes] = *row;
+			TableSize t;
+			t.name = std::string(name);
+			t.rows = rows;
+			t.data_bytes = data_bytes;
+			t.index_bytes = index_bytes;
+			sizes.push_back(std::move(t));
+		}
+		return sizes;
+	}
+
+	void TableGrowth::record(uint64_t now_ms, const std::vector<TableSize>& sizes) {
+		std::unordered_map<std::string, Ring> rings;
+		rings.reserve(sizes.size());
+		for (const auto& size : sizes) {
+			auto it = rings_.find(size.name);
+			Ring ring = (it != rings_.end()) ? std::move(it->second) : Ring{};
+			ring.samples[ring.next] = {now_ms, size.bytes(), size.rows};
+			ring.next = (ring.next + 1) % WINDOW;
+			ring.count = std::min(ring.count + 1, WINDOW);
+			ring.latest = size;
+			rings.emplace(size.name, std::move(ring));
+		}
+		rings_ = std::move(rings);
+	}
+
+	TableReport TableGrowth::report(uint64_t limit_bytes) const {
+		TableReport report;
+		report.limit_bytes = limit_bytes;
+		for (const auto& [name, ring] : rings_) {
+			TableSize t = ring.latest;
+			const Sample& oldest = ring.samples[(ring.next + WINDOW - ring.count) % WINDOW];
+			const Sample& newest = ring.samples[(ring.next + WINDOW - 1) % WINDOW];
+			report.samples = std::max(report.samples, ring.count);
+			report.window_ms = std::max(report.window_ms, newest.ms - oldest.ms);
+			
+			if (ring.count >= 2 && newest.ms > oldest.ms) {
+				// Least squares slope per hour, relative to the oldest sample to keep the sums small
+				double n = 0, sx = 0, sxx = 0, sb = 0, sxb = 0, sr = 0, sxr = 0;
+				for (size_t i = 0; i < ring.count; i++) {
+					const Sample& sample = ring.samples[(ring.next + WINDOW - ring.count + i) % WINDOW];
+					const double hours = (sample.ms - oldest.ms) / 3600000.0;
+					const double bytes = (double)sample.bytes - (double)oldest.bytes;
+					const double rows = (double)(sample.rows - oldest.rows);
+					n += 1;
+					sx += hours;
+					sxx += hours * hours;
+					sb += bytes;
+					sxb += hours * bytes;
+					sr += rows;
+					sxr += hours * rows;
+				}
+				const double denominator = n * sxx - sx * sx;
+				if (denominator > 0) {
+					t.bytes_per_hour = (n * sxb - sx * sb) / denominator;
+					t.rows_per_hour = (n * sxr - sx * sr) / denominator;
+				}
+			}
+			
+			if (limit_bytes > 0) {
+				if (t.bytes() >= limit_bytes) t.hours_to_limit = 0.0;
+				else if (t.bytes_per_hour > 0) t.hours_to_limit = (limit_bytes - t.bytes()) / t.bytes_per_hour;
+			}
+			report.tables.push_back(std::move(t));
+		}
+		
+		std::sort(report.tables.begin(), report.tables.end(), [](const TableSize& a, const TableSize& b) {
+			if (a.bytes_per_hour != b.bytes_per_hour) return a.bytes_per_hour > b.bytes_per_hour;
+			return a.bytes() > b.bytes();
+		});
+		return report;
+	}
+
+	LockReport Query::fetch_locks() {
+		LockReport report;
+		const uint64_t now = time_ms();
+		const bool baseline = (last_locks_ms_ == 0);
+		// Digests active since the previous read, with a second of slack for clock granularity
+		const int window_s = baseline ? DIGEST_BASELINE_S : (int)((now - last_locks_ms_ + 999) / 1000) + 1;
+		report.interval_s = baseline ? 0.0 : (now - last_locks_ms_) / 1000.0;
+		
+		// Transactions of the worldserver's connections, or of everyone but this connection
+		std::string user = config_.worldserver_db_user;
+		std::erase_if(user, [](char c) { return c == '\'' || c == '"' || c == '\\'; });
+		const std::string trx_filter = user.empty()
+			? "trx_mysql_thread_id <> CONNECTION_ID()"
+			: "trx_mysql_thread_id IN (SELECT PROCESSLIST_ID FROM performance_schema.threads WHERE PROCESSLIST_USER = '" + user + "')";
+		
+		// One round trip, rows tagged by kind: W lock wait summary, T transaction, D statement digest
+		std::string result = mysql_exec(
+			"SELECT 'W', COUNT(*), IFNULL(MAX(TIMESTAMPDIFF(SECOND, trx_wait_started, NOW())), 0), 0, '', '' "
+			"FROM information_schema.INNODB_TRX WHERE trx_state = 'LOCK WAIT' AND " + trx_filter + " "
+			"UNION ALL "
+			"(SELECT 'T', trx_mysql_thread_id, TIMESTAMPDIFF(SECOND, trx_started, NOW()), trx_rows_locked, trx_state, "
+			"  IFNULL(LEFT(trx_query, 80), '') "
+			"FROM information_schema.INNODB_TRX WHERE " + trx_filter + " "
+			"ORDER BY trx_started LIMIT " + std::to_string(LOCK_TRANSACTIONS) + ") "
+			"UNION ALL "
+			"(SELECT 'D', COUNT_STAR, ROUND(SUM_TIMER_WAIT / 1000000000), FIRST_SEEN >= NOW() - INTERVAL " + std::to_string(window_s) + " SECOND, "
+			"  DIGEST, IFNULL(LEFT(DIGEST_TEXT, 80), '') "
+			"FROM performance_schema.events_statements_summary_by_digest "
+			"WHERE SCHEMA_NAME = DATABASE() AND LAST_SEEN >= NOW() - INTERVAL " + std::to_string(window_s) + " SECOND);",
+			QueryPriority::LOW);
+		
+		for (const auto& row : Mysql::rows<std::string_view, int64_t, int64_t, int64_t, std::string_view, std::string_view>(result)) {
+			if (!row) continue;
+			auto [kind, a, b, c, text1, text2] = *row;
+			report.available = true;
+			if (kind == "W") {
+				report.lock_waits = (int)a;
+				report.longest_wait_s = (int)b;
+			}
+			else if (kind == "T") {
+				report.transactions.push_back({(int)a, (int)b, c, std::string(text1), std::string(text2)});
+			}
+			else if (kind == "D") {
+				// Per-interval numbers are differences of the cumulative counters. A digest seen for the
+				// first time counts in full only when it is new, otherwise it just becomes a baseline.
+				const std::string digest(text1);
+				auto it = digest_totals_.find(digest);
+				int64_t calls = 0, ms = 0;
+				if (it != digest_totals_.end()) {
+					calls = a - it->second.first;
+					ms = b - it->second.second;
+					if (calls < 0 || ms < 0) calls = a, ms = b;  // Counters were reset
+				}
+				else if (c != 0 && !baseline) {
+					calls = a;
+					ms = b;
+				}
+				digest_totals_[digest] = {a, b};
+				if (calls > 0) {
+					report.statement_ms += ms;
+					report.digests.push_back({digest, std::string(text2), calls, ms});
+				}
+			}
+		}
+		
+		if (report.available) last_locks_ms_ = now;
+		std::sort(report.digests.begin(), report.digests.end(), [](const DigestDelta& x, const DigestDelta& y) { return x.ms > y.ms; });
+		if (report.digests.size() > LOCK_DIGESTS) report.digests.resize(LOCK_DIGESTS);
+		return report;
+	}
+
+	std::shared_ptr<const Names::Index> name_index() {
+		std::lock_guard lock(name_index_mutex);
+		return current_name_index;
+	}
+
+	//* BotList implementation
+	void BotList::attach(CommandExecutor* executor, const ServerConfig& config) {
+		std::lock_guard lock(mutex_);
+		executor_ = executor;
+		config_ = config;
+		reattached_ = true;
+		generation_++;
+	}
+
+	void BotList::open(int zone_id, int expected_min, int expected_max) {
+		std::lock_guard lock(mutex_);
+		if (!worker_.joinable()) worker_ = std::jthread([this](std::stop_token stop) { run(stop); });
+		generation_++;
+		zone_id_ = zone_id;
+		expected_min_ = expected_min;
+		expected_max_ = expected_max;
+		rows_.clear();
+		last_guid_ = 0;
+		complete_ = false;
+		requested_ = true;
+		wake_.notify_one();
+	}
+
+	void BotList::close() {
+		std::lock_guard lock(mutex_);
+		generation_++;
+		zone_id_ = -1;
+		rows_.clear();
+		last_guid_ = 0;
+		complete_ = true;
+		requested_ = false;
+	}
+
+	void BotList::request_stop() {
+		std::lock_guard lock(mutex_);
+		worker_.request_stop();
+	}
+	
+	void BotList::stop() {
+		close();
+		// Joined outside the lock, the worker takes it on its way out
+		std::jthread worker;
+		{
+			std::lock_guard lock(mutex_);
+			worker = std::move(worker_);
+		}
+		if (worker.joinable()) {
+			worker.request_stop();
+			worker.join();
+		}
+		std::lock_guard lock(mutex_);
+		query_.reset();
+		executor_ = nullptr;
+	}
+
+	void BotList::want(size_t row) {
+		std::lock_guard lock(mutex_);
+		if (zone_id_ < 0 || complete_ || requested_) return;
+		if (row + PREFETCH_ROWS >= rows_.size()) {
+			requested_ = true;
+			wake_.notify_one();
+		}
+	}
+
+	int BotList::zone_id() {
+		std::lock_guard lock(mutex_);
+		return zone_id_;
+	}
+
+	size_t BotList::size() {
+		std::lock_guard lock(mutex_);
+		return rows_.size();
+	}
+
+	bool BotList::complete() {
+		std::lock_guard lock(mutex_);
+		return complete_;
+	}
+
+	std::optional<BotRow> BotList::row(size_t index) {
+		std::lock_guard lock(mutex_);
+		if (index >= rows_.size()) return std::nullopt;
+		return rows_[index];
+	}
+
+	void BotList::run(std::stop_token stop) {
+		std::unique_lock lock(mutex_);
+		while (true) {
+			wake_.wait(lock, stop, [this] { return requested_ && !complete_; });
+			if (stop.stop_requested()) return;
+			
+			const uint64_t generation = generation_;
+			const int zone = zone_id_, expected_min = expected_min_, expected_max = expected_max_;
+			const int after = last_guid_;
+			CommandExecutor* executor = executor_;
+			if (std::exchange(reattached_, false)) query_.reset();
+			//? Copied under the lock, attach() may change it while the page is read
+			const std::optional<ServerConfig> config = query_ ? std::nullopt : std::optional(config_);
+			lock.unlock();
+			
+			// The Query is the worker's own, the collector's one is busy with its cycles
+			const auto cancel = Cancel::within(stop, std::chrono::milliseconds(PAGE_DEADLINE_MS));
+			std::vector<BotRow> page;
+			if (!query_ && executor) query_ = std::make_unique<Query>(*executor, *config, nullptr, "bots|", cancel);
+			if (query_) {
+				query_->set_cancel(cancel);
+				query_->revalidate();
+				page = query_->fetch_zone_bots(zone, expected_min, expected_max, after, PAGE_SIZE);
+			}
+			
+			lock.lock();
+			if (stop.stop_requested()) return;
+			if (generation != generation_) continue;  // Another zone was opened, or the list attached elsewhere, meanwhile
+			for (const auto& bot : page) last_guid_ = std::max(last_guid_, bot.guid);
+			rows_.insert(rows_.end(), page.begin(), page.end());
+			complete_ = (int)page.size() < PAGE_SIZE;
+			requested_ = false;
+		}
+	}
+
+	//* Realms
+	std::vector<RealmConfig> parse_realms(const ServerConfig& config) {
+		std::vector<RealmConfig> realms{{"main", config}};
+		std::istringstream entries(config.realms);
+		std::string entry;
+		while (entries >> entry) {
+			std::vector<std::string> fields;
+			std::istringstream parts(entry);
+			for (std::string field; std::getline(parts, field, '|');) fields.push_back(field);
+			if (fields.size() < 3 || fields.size() > 4 || fields[0].empty() || fields[1].empty() || fields[2].empty()) {
+				Logger::warning("azerothcore_realms: skipping \"" + entry + "\", expected name|host|container[|db_host]");
+				continue;
+			}
+			RealmConfig realm{fields[0], config};
+			realm.server.realms.clear();
+			realm.server.use_local = (fields[1] == "local");
+			realm.server.ssh_host = realm.server.use_local ? "" : fields[1];
+			realm.server.container = fields[2];
+			if (fields.size() == 4 && !fields[3].empty()) realm.server.db_host = fields[3];
+			realms.push_back(std::move(realm));
+		}
+		return realms;
+	}
+
+	//* Host a realm is shown under and its connection shared by, "local" for Docker on this machine
+	static std::string realm_host(const ServerConfig& server) {
+		return server.use_local ? std::string("local") : server.ssh_host;
+	}
+	
+	void RealmWatch::start(const std::vector<RealmConfig>& realms, size_t primary) {
+		stop();
+		std::lock_guard lock(mutex_);
+		
+		//? Watched realms connect on their own, an SSH connection runs one command at a time and
+		//? sharing the main view's would hold its cycle up behind a slow realm
+		std::unordered_map<std::string, std::shared_ptr<Host>> hosts;
+		
+		for (size_t i = 0; i < realms.size(); i++) {
+			RealmSummary summary;
+			summary.name = realms[i].name;
+			summary.host = realm_host(realms[i].server);
+			summary.primary = (i == primary);
+			order_.push_back(summary);
+			if (summary.primary) continue;
+			
+			auto& host = hosts[summary.host];
+			if (!host) host = std::make_shared<Host>();
+			auto realm = std::make_unique<Realm>();
+			realm->config = realms[i];
+			realm->slot = i;
+			realm->host = host;
+			realm->summary = std::move(summary);
+			realm->budget.set_limit(std::max(0, realms[i].server.rtt_budget_ms));
+			realms_.push_back(std::move(realm));
+		}
+		
+		const size_t count = std::min(realms_.size(), MAX_WORKERS);
+		for (size_t i = 0; i < count; i++) workers_.emplace_back([this](std::stop_token stop) { run(stop); });
+	}
+
+	void RealmWatch::request_stop() {
+		std::lock_guard lock(mutex_);
+		for (auto& worker : workers_) worker.request_stop();
+		wake_.notify_all();
+	}
+	
+	void RealmWatch::stop() {
+		// Joined outside the lock, the workers take it on their way out
+		std::vector<std::jthread> workers;
+		{
+			std::lock_guard lock(mutex_);
+			workers.swap(workers_);
+		}
+		for (auto& worker : workers) worker.request_stop();
+		wake_.notify_all();
+		workers.clear();  // jthread joins
+		std::lock_guard lock(mutex_);
+		realms_.clear();
+		order_.clear();
+	}
+
+	std::vector<RealmSummary> RealmWatch::summaries() {
+		std::lock_guard lock(mutex_);
+		auto out = order_;
+		for (const auto& realm : realms_) out[realm->slot] = realm->summary;
+		return out;
+	}
+
+	void RealmWatch::run(std::stop_token stop) {
+		std::unique_lock lock(mutex_);
+		while (!stop.stop_requested()) {
+			//? The realm due first that no other worker is polling
+			Realm* next = nullptr;
+			for (const auto& realm : realms_) {
+				if (!realm->busy && (!next || realm->due_ms < next->due_ms)) next = realm.get();
+			}
+			//? Woken when a poll finishes, a realm it held may be due before the one waited for
+			const uint64_t seen = finished_;
+			auto finished = [this, seen] { return finished_ != seen; };
+			if (!next) {
+				wake_.wait(lock, stop, finished);
+				continue;
+			}
+			const uint64_t now = time_ms();
+			if (next->due_ms > now) {
+				wake_.wait_for(lock, stop, std::chrono::milliseconds(next->due_ms - now), finished);
+				continue;
+			}
+			
+			next->busy = true;
+			lock.unlock();
+			auto summary = poll(*next, stop);
+			lock.lock();
+			next->summary = std::move(summary);
+			next->due_ms = time_ms() + std::max(POLL_MS, eco_interval_ms.load());
+			next->busy = false;
+			finished_++;
+			wake_.notify_all();
+		}
+	}
+
+	RealmSummary RealmWatch::poll(Realm& realm, std::stop_token stop) {
+		RealmSummary summary = realm.summary;
+		const auto& server = realm.config.server;
+		// A poll never runs into the next one, and stop() ends it within tens of ms
+		const auto cancel = Cancel::within(stop, std::chrono::milliseconds(POLL_MS));
+		summary.polled = true;
+		summary.updated_ms = time_ms();
+		
+		std::shared_ptr<CommandExecutor> executor;
+		{
+			std::lock_guard lock(realm.host->mutex);
+			if (!realm.host->executor || !realm.host->executor->is_connected()) {
+				if (server.use_local) {
+					realm.host->executor = std::make_shared<LocalExecutor>();
+				} else {
+					auto ssh = std::make_shared<SSHClient>(server.ssh_host);
+					if (!ssh->connect(cancel)) {
+						summary.status = ServerStatus::ERROR;
+						summary.error = "Failed to connect: " + ssh->last_error();
+						return summary;
+					}
+					realm.host->executor = std::move(ssh);
+				}
+				realm.host->generation++;
+			}
+			//? Another realm on the host may have reconnected, a query on the old executor is dropped with it
+			if (realm.generation != realm.host->generation) {
+				realm.query.reset();
+				realm.executor = realm.host->executor;
+				realm.generation = realm.host->generation;
+			}
+			executor = realm.executor;
+		}
+		
+		try {
+			const std::string status = executor->execute("docker ps --filter name=" + server.container + " --format '{{.Status}}'", cancel);
+			if (stop.stop_requested()) return summary;
+			if (status.find("Up") == std::string::npos) {
+				summary.status = ServerStatus::OFFLINE;
+				summary.error = "Server container is not running";
+				summary.perf = false;
+				if (realm.query) realm.query->forget_performance();
+				return summary;
+			}
 			
-			Logger::error("FETCH_ALL DEBUG: About to call fetch_ollama_stats()");
-			data.ollama = fetch_ollama_stats();
-			Logger::error("FETCH_ALL DEBUG: fetch_ollama_stats() returned");
+			if (!realm.query) realm.query = std::make_unique<Query>(*executor, server, &realm.budget, "realm:" + realm.config.name + "|", cancel);
+			realm.query->set_cancel(cancel);
+			realm.query->revalidate();
+			const auto stats = realm.query->fetch_bot_stats();
+			summary.status = ServerStatus::ONLINE;
+			summary.error.clear();
+			summary.bots = stats.total;
+			summary.perf = stats.perf.available;
+			summary.mean_ms = stats.perf.mean;
+			summary.p99_ms = stats.perf.p99;
 		} catch (const std::exception& e) {
-			Logger::error("FETCH_ALL DEBUG: Exception caught: " + std::string(e.what()));
-			data.error = e.what();
+			summary.status = ServerStatus::ERROR;
+			summary.error = e.what();
 		}
-		
-		Logger::error("FETCH_ALL DEBUG: Returning from fetch_all()");
-		return data;
+		summary.updated_ms = time_ms();
+		return summary;
 	}
 
 	//* Module functions
 	void init() {
+		// Whatever init ends with, connected or an error, is what the UI shows until the first cycle
+		struct PublishOnExit {
+			~PublishOnExit() { publish(); }
+		} publish_on_exit;
+		
 		// File-based debug logging since Logger might not be ready
 		std::ofstream debug_log("/tmp/bottop_init_debug.log", std::ios::app);
 		debug_log << "\n=== INIT CALLED ===" << std::endl;
@@ -1556,13 +2959,21 @@ namespace AzerothCore {
 			return;
 		}
 		
+		//? The first init runs on the main thread before the collector starts, later settings come through reconfigure()
+		if (realm_configs.empty()) {
+			realm_configs = parse_realms(config);
+			eco_idle_s = config.eco_idle_s;
+			eco_ms = config.eco_ms;
+		}
+		
 		try {
 			// Auto-detect if we should use local Docker
 			if (config.ssh_host.empty() || config.ssh_host == "localhost" || config.ssh_host == "127.0.0.1") {
 				// Force local mode if ssh_host is empty or localhost
 				config.use_local = true;
 				debug_log << "SSH host is empty/localhost, forcing local mode" << std::endl;
-			} else if (!config.use_local) {
+			} else if (!config.use_local && primary_realm == 0) {
+				// Only for the configured server, the other realms name their host explicitly
 				// Check if Docker is available locally with AzerothCore containers
 				FILE* pipe = popen("docker ps --filter 'name=ac-' --format '{{.Names}}' 2>/dev/null | head -1", "r");
 				if (pipe) {
@@ -1585,6 +2996,9 @@ namespace AzerothCore {
 				}
 			}
 			
+			// A Query may hold a session on the executor, so it goes first
+			query.reset();
+			
 			// Create appropriate executor
 			if (config.use_local) {
 				debug_log << "Using local Docker mode" << std::endl;
@@ -1598,7 +3012,7 @@ namespace AzerothCore {
 				Logger::error("Initializing SSH connection to " + config.ssh_host);
 				
 				auto ssh = std::make_unique<SSHClient>(config.ssh_host);
-				if (!ssh->connect()) {
+				if (!ssh->connect(cycle_cancel)) {
 					debug_log << "SSH connection failed: " << ssh->last_error() << std::endl;
 					std::cerr << "[BOTTOP DEBUG] SSH connection failed: " << ssh->last_error() << std::endl;
 					current_data.error = "Failed to connect: " + ssh->last_error();
@@ -1610,15 +3024,17 @@ namespace AzerothCore {
 			
 			debug_log << "Executor created successfully, creating Query object" << std::endl;
 			std::cerr << "[BOTTOP DEBUG] Executor ready, creating Query object" << std::endl;
-			query = std::make_unique<Query>(*executor, config);
-			active = true;
+			load_budget.set_limit(std::max(0, config.rtt_budget_ms));
 			
-			debug_log << "About to call load_expected_values()" << std::endl;
-			std::cerr << "[BOTTOP DEBUG] About to call load_expected_values()" << std::endl;
-			// Load expected values from config file
-			load_expected_values();
-			debug_log << "load_expected_values() returned, brackets loaded: " << expected_values.bracket_definitions.size() << std::endl;
-			std::cerr << "[BOTTOP DEBUG] load_expected_values() returned" << std::endl;
+			// Discovery names the container the query runs its commands in. The cache of an earlier run
+			// saves the round trip, the first cycle revalidates it.
+			if (!load_cached_discovery()) load_expected_values();
+			debug_log << "Discovery done, brackets loaded: " << expected_values.bracket_definitions.size() << std::endl;
+			
+			query = std::make_unique<Query>(*executor, config, nullptr, "main|", cycle_cancel);
+			if (!last_discovery.excluded.empty() && last_discovery.excluded != "NULL") query->set_excluded_accounts(last_discovery.excluded);
+			bot_list.attach(executor.get(), config);
+			active = true;
 		} catch (const std::exception& e) {
 			debug_log << "Exception in init(): " << e.what() << std::endl;
 			std::cerr << "[BOTTOP DEBUG] Exception in init(): " << e.what() << std::endl;
@@ -1634,7 +3050,7 @@ namespace AzerothCore {
 		try {
 			// Check if container is running
 			std::string cmd = "docker ps --filter name=" + config.container + " --format '{{.Status}}'";
-			std::string status = executor->execute(cmd);
+			std::string status = executor->execute(cmd, cycle_cancel);
 			
 			// If output contains "Up", container is running
 			return status.find("Up") != std::string::npos;
@@ -1646,23 +3062,53 @@ namespace AzerothCore {
 	void reset_stats() {
 		Logger::info("Resetting all stats and clearing display data");
 		
-		// Clear all data
+		// Clear all data, advice already asked for is kept so it isn't run again
+		auto advice = std::move(current_data.advice);
+		const uint64_t advice_request = current_data.advice_request;
 		current_data = ServerData();
+		current_data.advice = std::move(advice);
+		current_data.advice_request = advice_request;
 		current_data.server_url = config.use_local ? "localhost (Docker)" : config.ssh_host;
 		current_data.status = ServerStatus::OFFLINE;
 		current_data.error = "Server disconnected or restarted";
 		
 		// Clear historical data
 		load_history.clear();
+		lock_wait_history.clear();
+		statement_ms_history.clear();
+		eco_history.clear();
 		
 		// Clear cached performance data
-		last_known_perf = ServerPerformance();
-		last_perf_update_time = 0;
+		if (query) query->forget_performance();
+		
+		// Next collection repopulates everything
+		query_cache.clear();
+		{
+			std::lock_guard lock(name_index_mutex);
+			current_name_index = std::make_shared<const Names::Index>();
+		}
+		next_full_cycle_time = 0;
+		next_exact_cycle_time = 0;
 		
 		Logger::info("Stats reset complete");
 	}
 	
-	void collect() {
+	//* Fold this cycle's positions into the name index, only the names of newcomers are read
+	void refresh_name_index(int online) {
+		auto previous = name_index();
+		std::vector<Names::Position> positions;
+		if (online > 0) {
+			auto fetched = query->fetch_online_positions();
+			if (!fetched) return;  // Shed or failed, keep searching the last index
+			positions = std::move(*fetched);
+		}
+		auto next = std::make_shared<const Names::Index>(previous->rebuild(positions, query->fetch_names(previous->missing(positions))));
+		std::lock_guard lock(name_index_mutex);
+		current_name_index = std::move(next);
+	}
+
+	//* One collection cycle into current_data, on the collector thread
+	void collect_cycle() {
 		if (!enabled || !active || !query) return;
 		
 		Logger::error("COLLECT DEBUG: collect() called at " + std::to_string(std::time(nullptr)));
@@ -1671,6 +3117,8 @@ namespace AzerothCore {
 		auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
 			std::chrono::system_clock::now().time_since_epoch()
 		).count();
+		// In eco mode only the status and the bot count are read, everything else is carried over
+		const bool eco = eco_interval_ms.load() > 0;
 		
 		try {
 			// First check if server is online
@@ -1693,6 +3141,9 @@ namespace AzerothCore {
 				
 				current_data.error = "Server container is not running";
 				
+				// A cached container name may be stale, look for the container again
+				if (discovery_unverified && container_discovered) load_expected_values();
+				
 				// Fetch container statuses to show detailed state
 				current_data.containers = query->fetch_container_statuses();
 				
@@ -1744,22 +3195,74 @@ namespace AzerothCore {
 		}
 		
 	// Periodic config refresh (every 90 seconds when server is online)
-	if (last_config_refresh_time == 0 || 
-	    (now_ms - last_config_refresh_time) >= CONFIG_REFRESH_INTERVAL_MS) {
+	if (!eco && (last_config_refresh_time == 0 ||
+	    (now_ms - last_config_refresh_time) >= CONFIG_REFRESH_INTERVAL_MS)) {
 		Logger::info("Performing periodic config refresh (90s interval)");
 		load_expected_values();
+		rebin_current();
 		last_config_refresh_time = now_ms;
-		
-		// Trigger bottop config reload via SIGUSR2 signal
-		kill(getpid(), SIGUSR2);
+		// New expected values and brackets reach the panes with this cycle's snapshot
 	}
 		
-		// Server is online and not rebuilding, try to fetch data
-		Logger::error("COLLECT DEBUG: Server online, calling fetch_all()");
-		ServerData new_data = query->fetch_all();
+		// Server is online and not rebuilding, try to fetch data.
+		// Full cycles are spaced out so bottop's own query round trips stay within the configured budget,
+		// in between only the bot count is refreshed and the distributions are carried over.
+		bool full_cycle = !eco && (uint64_t)now_ms >= next_full_cycle_time;
+		uint64_t shed_before = load_budget.stats().shed;
+		uint64_t spent_before = load_budget.total();
+		
+		Logger::error("COLLECT DEBUG: Server online, calling fetch_all(full=" + std::to_string(full_cycle) + ")");
+		// With sampling enabled, every few minutes a full cycle counts exactly to reconcile the estimates
+		bool exact_cycle = full_cycle && (uint64_t)now_ms >= next_exact_cycle_time;
+		ServerData new_data = query->fetch_all(full_cycle, exact_cycle);
+		
+		if (full_cycle) {
+			next_full_cycle_time = now_ms + load_budget.full_cycle_spacing(load_budget.total() - spent_before);
+			if (exact_cycle) next_exact_cycle_time = now_ms + SAMPLE_RECONCILE_MS;
+		} else {
+			// Summary cycles already carry fresh distributions
+			if (!new_data.summary.active) {
+				new_data.sample = current_data.sample;
+				new_data.continents = current_data.continents;
+				new_data.factions = current_data.factions;
+				new_data.zones = current_data.zones;
+				new_data.levels = current_data.levels;
+				new_data.level_histogram = current_data.level_histogram;
+				new_data.cube = current_data.cube;
+			}
+			new_data.ollama = current_data.ollama;
+		}
+		
+		// Keep the last known sections for anything admission control shed this cycle
+		if (load_budget.stats().shed != shed_before) {
+			if (new_data.continents.empty()) new_data.continents = current_data.continents;
+			if (new_data.factions.empty()) new_data.factions = current_data.factions;
+			if (new_data.zones.empty()) {
+				new_data.zones = current_data.zones;
+				new_data.levels = current_data.levels;
+				new_data.level_histogram = current_data.level_histogram;
+				new_data.sample = current_data.sample;
+				new_data.cube = current_data.cube;
+			}
+			if (!new_data.ollama.enabled) new_data.ollama = current_data.ollama;
+		}
+		
+		// Table sizes change slowly, a sample every few minutes is plenty for growth rates
+		if (!eco && (uint64_t)now_ms >= next_tables_time) {
+			auto sizes = query->fetch_table_sizes();
+			if (!sizes.empty()) table_growth.record(now_ms, sizes);
+			next_tables_time = now_ms + (sizes.empty() ? TABLES_RETRY_MS : TABLES_INTERVAL_MS);
+		}
+		new_data.tables = table_growth.report((uint64_t)std::max(config.table_limit_mb, 0) * 1024 * 1024);
+		new_data.locks = eco ? current_data.locks : query->fetch_locks();
+		new_data.health = eco ? current_data.health : query->fetch_health();
+		new_data.eco = eco;
 		
 		// Fetch container statuses for ONLINE state too
 		new_data.containers = query->fetch_container_statuses();
+		new_data.budget = load_budget.stats();
+		new_data.executor = executor->stats();
+		new_data.cache = query_cache.stats();
 
 		
 		// DEBUG: Log what we got back
@@ -1793,6 +3296,17 @@ namespace AzerothCore {
 			if (load_history.size() > 300) {
 				load_history.pop_front();
 			}
+			// Lock series share the update-time timeline, -1 marks a cycle where the read was shed
+			const bool locks_read = current_data.locks.available && !eco;
+			lock_wait_history.push_back(locks_read ? current_data.locks.lock_waits : -1);
+			statement_ms_history.push_back(locks_read ? current_data.locks.statement_ms : -1);
+			eco_history.push_back(eco);
+			while (lock_wait_history.size() > load_history.size()) lock_wait_history.pop_front();
+			while (statement_ms_history.size() > load_history.size()) statement_ms_history.pop_front();
+			while (eco_history.size() > load_history.size()) eco_history.pop_front();
+			
+			// Newcomers' names wait for full rate, the search prompt ends eco mode anyway
+			if (!eco) refresh_name_index(current_data.stats.total);
 			
 		} catch (const std::exception& e) {
 			current_data.error = std::string("Collect error: ") + e.what();
@@ -1805,20 +3319,526 @@ namespace AzerothCore {
 		}
 	}
 
-	void load_expected_values() {
-		// File-based debug logging
-		std::ofstream debug_log("/tmp/bottop_init_debug.log", std::ios::app);
-		debug_log << "\n=== LOAD_EXPECTED_VALUES CALLED ===" << std::endl;
+	std::shared_ptr<const ServerData> snapshot() {
+		return published.load();
+	}
+	
+	bool take_published() {
+		uint64_t count;
+		if (publish_event >= 0) while (read(publish_event, &count, sizeof(count)) > 0) {}
+		return fresh.exchange(false);
+	}
+	
+	int published_fd() {
+		return publish_event;
+	}
+	
+	//* Copy the working state into a new immutable snapshot
+	void publish() {
+		auto data = std::make_shared<ServerData>(current_data);
+		data->load_history = load_history;
+		data->lock_wait_history = lock_wait_history;
+		data->statement_ms_history = statement_ms_history;
+		data->eco_history = eco_history;
+		data->expected = expected_values;
+		data->realms.clear();
+		for (size_t i = 0; i < realm_configs.size(); i++) {
+			RealmSummary realm;
+			realm.name = realm_configs[i].name;
+			realm.host = realm_host(realm_configs[i].server);
+			realm.primary = (i == primary_realm);
+			data->realms.push_back(std::move(realm));
+		}
+		published.store(std::move(data));
+		fresh = true;
+		const uint64_t one = 1;
+		if (publish_event >= 0 && write(publish_event, &one, sizeof(one)) < 0) {}
+	}
+	
+	//* Drop the connection and everything learned over it, then connect with server
+	void reconnect(const ServerConfig& server) {
+		// Watchers restart with the realm shown now left out, the bot list reads through the query
+		realm_watch.stop();
+		bot_list.stop();
+		query.reset();
+		executor.reset();
+		active = false;
 		
-		std::cerr << "[BOTTOP DEBUG] load_expected_values: === STARTING BRACKET CONFIG LOAD ===" << std::endl;
-		Logger::error("load_expected_values: === STARTING BRACKET CONFIG LOAD ===");
+		config = server;
+		last_discovery = {};
+		container_discovered = config_path_discovered = discovery_unverified = false;
+		next_accounts_time = 0;
+		table_growth.clear();
+		next_tables_time = 0;
+		previous_status = ServerStatus::ONLINE;
+		reset_stats();
+		current_data.error.clear();
+		init();
+		if (realm_configs.size() > 1) realm_watch.start(realm_configs, primary_realm);
+	}
+	
+	//* Put realm index in the main view, on the collector thread. The realm shown so far joins the overview.
+	void enter_realm(size_t index) {
+		if (index >= realm_configs.size() || index == primary_realm) return;
+		Logger::info("Switching to realm " + realm_configs[index].name);
+		primary_realm = index;
+		reconnect(realm_configs[index].server);
+	}
+	
+	//* Settings that only tune the collection are swapped in, the rest is baked into the connection and the query
+	void apply_config(const ServerConfig& next, bool reconnect_needed) {
+		if (reconnect_needed) {
+			Logger::info("AzerothCore settings changed, reconnecting to the configured server");
+			realm_configs = parse_realms(next);
+			primary_realm = 0;
+			reconnect(next);
+			return;
+		}
+		config.rtt_budget_ms = next.rtt_budget_ms;
+		config.table_limit_mb = next.table_limit_mb;
+		load_budget.set_limit(std::max(0, config.rtt_budget_ms));
+	}
+	
+	void collector_loop() {
+		// Signals stay with the main thread, it reads them from its event loop
+		sigset_t mask;
+		sigfillset(&mask);
+		for (int sig : {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT, SIGTRAP}) sigdelset(&mask, sig);
+		pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+		
+		// Workers inherit the mask above
+		if (realm_configs.size() > 1) realm_watch.start(realm_configs, primary_realm);
+		
+		std::unique_lock lock(collector_mutex);
+		while (true) {
+			collector_cv.wait(lock, [] { return collect_requested || collector_stopping; });
+			if (collector_stopping) return;
+			collect_requested = false;
+			auto next_config = std::exchange(pending_config, std::nullopt);
+			const bool next_reconnect = std::exchange(pending_reconnect, false);
+			const uint64_t next_advice = advice_requested;
+			// A stop meant for the previous cycle does not carry over
+			if (cycle_stop.stop_requested()) cycle_stop = std::stop_source();
+			cycle_cancel = Cancel::within(cycle_stop.get_token(), std::chrono::milliseconds(CYCLE_DEADLINE_MS));
+			lock.unlock();
+			
+			try {
+				if (next_config) apply_config(*next_config, next_reconnect);
+				if (const int realm = requested_realm.exchange(-1); realm >= 0) enter_realm(static_cast<size_t>(realm));
+				if (query) query->set_cancel(cycle_cancel);
+				// Entries the last cycle was served stale are refreshed, under this cycle's cancel, before it
+				// reads them. The refresh runs on this thread and delays this snapshot, not the one that
+				// served the stale value. Eco cycles don't read them.
+				if (query && eco_interval() == 0) query->revalidate();
+				collect_cycle();
+				// Published with the cycle, an abandoned run is asked again by the next one
+				if (query && next_advice > current_data.advice_request && !cycle_cancel.stop.stop_requested()) {
+					query->set_cancel(Cancel::within(cycle_cancel.stop, std::chrono::milliseconds(CYCLE_DEADLINE_MS)));
+					auto advice = std::make_shared<const Advisor::Report>(query->advise());
+					if (!cycle_cancel.stop.stop_requested()) {
+						current_data.advice = std::move(advice);
+						current_data.advice_request = next_advice;
+					}
+				}
+			}
+			catch (const std::exception& e) {
+				Logger::error("AzerothCore::collect() -> " + std::string(e.what()));
+				current_data.error = "Collect error: " + std::string(e.what());
+			}
+			// A cycle stopped half way is not shown, whoever stopped it has the next one run
+			if (!cycle_cancel.stop.stop_requested()) {
+				// Wakes the main loop through the publish eventfd, so it draws the new snapshot right away
+				publish();
+			}
+			
+			lock.lock();
+		}
+	}
+	
+	//* Start the collector if needed and have it run a cycle, abort_cycle first stops the one running
+	void wake_collector(bool abort_cycle = false) {
+		std::lock_guard lock(collector_mutex);
+		if (!collector.joinable()) collector = std::thread(collector_loop);
+		if (abort_cycle) cycle_stop.request_stop();
+		collect_requested = true;
+		collector_cv.notify_one();
+	}
+	
+	void collect() {
+		if (!enabled || !active || !query) return;
+		wake_collector();
+	}
+	
+	uint64_t request_advice() {
+		uint64_t request;
+		{
+			std::lock_guard lock(collector_mutex);
+			request = ++advice_requested;
+		}
+		wake_collector();
+		return request;
+	}
+	
+	void switch_realm(size_t index) {
+		if (!enabled || index >= snapshot()->realms.size()) return;
+		requested_realm = static_cast<int>(index);
+		//? Also when the realm shown now failed to connect, so there is a way out of it
+		wake_collector(true);
+	}
+	
+	void reconfigure(const ServerConfig& next, bool reconnect_needed) {
+		if (!enabled) return;
+		// Read by eco_update() on this thread, the collector only sees the interval it results in
+		eco_idle_s = next.eco_idle_s;
+		eco_ms = next.eco_ms;
+		{
+			std::lock_guard lock(collector_mutex);
+			pending_reconnect = pending_reconnect || reconnect_needed;
+			pending_config = next;
+		}
+		//? Also when the server failed to connect, new settings are the way out of it
+		wake_collector(reconnect_needed);
+	}
+	
+	//* Whether tmux or screen say our window can't be seen. Focus reports don't cover a detach.
+	static bool multiplexer_hidden() {
+		const char* tmux_pane = std::getenv("TMUX_PANE");
+		if (std::getenv("TMUX") && tmux_pane) {
+			const std::string pane = tmux_pane;
+			if (pane.size() < 2 || pane[0] != '%' || !std::all_of(pane.begin() + 1, pane.end(), ::isdigit)) return false;
+			auto out = LocalExecutor().execute("tmux display-message -p -t '" + pane + "' '#{session_attached} #{window_active}' 2>/dev/null",
+			                                   Cancel::within({}, std::chrono::milliseconds(1000)));
+			int attached = 1, window_active = 1;
+			std::istringstream(out) >> attached >> window_active;
+			return attached == 0 || window_active == 0;
+		}
+		if (const char* sty = std::getenv("STY")) {
+			// screen clears the owner execute bit of the session socket while it is detached
+			std::vector<std::string> dirs;
+			if (const char* dir = std::getenv("SCREENDIR")) dirs.push_back(dir);
+			if (struct passwd* pw = getpwuid(getuid())) {
+				for (const char* base : {"/run/screen/S-", "/var/run/screen/S-", "/tmp/screens/S-"}) dirs.push_back(base + std::string(pw->pw_name));
+			}
+			struct stat st;
+			for (const auto& dir : dirs) {
+				if (stat((dir + "/" + sty).c_str(), &st) == 0) return !(st.st_mode & S_IXUSR);
+			}
+		}
+		return false;
+	}
+	
+	void eco_focus(bool focused) {
+		term_focused = focused;
+		if (focused) eco_activity();
+	}
+	
+	void eco_activity() {
+		last_activity_ms = time_ms();
+		// Input means someone is there, the multiplexer is asked again on the next eco_update()
+		window_hidden = false;
+		next_window_check_ms = last_activity_ms + WINDOW_CHECK_MS;
+	}
+	
+	bool eco_update() {
+		const uint64_t now = time_ms();
+		if (last_activity_ms == 0) last_activity_ms = now;
+		bool eco = false;
+		const int idle_s = eco_idle_s.load();
+		if (enabled && idle_s > 0) {
+			if (now >= next_window_check_ms) {
+				window_hidden = multiplexer_hidden();
+				next_window_check_ms = now + WINDOW_CHECK_MS;
+			}
+			eco = !term_focused || window_hidden || now - last_activity_ms >= (uint64_t)idle_s * 1000;
+		}
+		const uint64_t interval = eco ? (uint64_t)std::max(eco_ms.load(), 1000) : 0;
+		if (eco_interval_ms.exchange(interval) == interval) return false;
+		Logger::info(eco ? "Entering eco mode, collecting every " + std::to_string(interval / 1000) + "s"
+		                 : "Leaving eco mode");
+		return true;
+	}
+	
+	uint64_t eco_interval() {
+		return eco_interval_ms.load();
+	}
+
+	//* Discovery script, one round trip. The container and worldserver.conf found last time are checked first
+	//* with a stat of both config files, which doubles as their fingerprint. The mtime is read to the nanosecond,
+	//* whole seconds miss an edit in the same second that keeps the size. Only when that fails are they
+	//* searched for again, unless configured. The files are sent when the fingerprint differs from
+	//* known.fingerprint, the excluded accounts when with_accounts.
+	static std::string discovery_script(const Discovery& known, bool with_accounts) {
+		const std::string container = container_discovered ? "" : config.container;
+		const std::string config_path = config_path_discovered ? "" : config.config_path;
+		std::ostringstream sh;
+		sh << "b=" << BRACKET_CONF_PATH << "; "
+		   << "c='" << (known.container.empty() ? container : known.container) << "'; "
+		   << "p='" << (known.config_path.empty() ? config_path : known.config_path) << "'; "
+		   << "f=$([ -n \"$c\" ] && docker exec \"$c\" stat -c %y:%s \"$p\" \"$b\" 2>/dev/null | tr -d ' ' | xargs); "
+		   << "if [ -z \"$f\" ]; then "
+		   << "c='" << container << "'; p='" << config_path << "'; "
+		   << "[ -n \"$c\" ] || c=$(docker ps --filter 'name=ac-worldserver' --format '{{.Names}}' | head -1); "
+		   << "[ -n \"$c\" ] || c=$(docker ps --filter 'name=worldserver' --format '{{.Names}}' | grep -i ac | head -1); "
+		   << "[ -n \"$c\" ] || c=$(docker ps --format '{{.Names}}' | grep -i worldserver | head -1); "
+		   << "[ -n \"$c\" ] || c=$(docker ps --format '{{.Names}}' | grep 'ac-' | head -1); "
+		   << "[ -n \"$c\" ] || { echo @@container; exit 0; }; "
+		   << "[ -n \"$p\" ] || p=$(docker exec \"$c\" sh -c 'for f in " << WORLDSERVER_CONF_PATHS
+		   << "; do [ -f $f ] && echo $f && break; done' 2>/dev/null); "
+		   << "f=$(docker exec \"$c\" stat -c %y:%s \"$p\" \"$b\" 2>/dev/null | tr -d ' ' | xargs); "
+		   << "fi; "
+		   << "echo @@container; echo \"$c\"; echo @@config_path; echo \"$p\"; echo @@fingerprint; echo \"$f\"; ";
+		if (with_accounts) {
+			sh << "echo @@excluded; docker exec \"$c\" mysql -h" << config.db_host << " -u" << config.db_user << " -p" << config.db_pass
+			   << " -sN -e \"SELECT GROUP_CONCAT(id) FROM acore_auth.account WHERE username IN (" << EXCLUDED_USERNAMES << ");\" 2>/dev/null; ";
+		}
+		sh << "[ -n \"$f\" ] && [ \"$f\" = '" << known.fingerprint << "' ] && exit 0; "
+		   << "echo @@worldserver_conf; docker exec \"$c\" grep -E 'AiPlayerbot[.](Min|Max)RandomBots' \"$p\" 2>/dev/null; "
+		   << "echo @@bracket_conf; docker exec \"$c\" cat \"$b\" 2>/dev/null";
+		return sh.str();
+	}
+	
+	//* Sections of the discovery script's output, also the format of the warm-start cache
+	static std::optional<Discovery> parse_discovery(const std::string& text) {
+		Discovery found;
+		std::string* section = nullptr;
+		bool configs_sent = false;
+		std::istringstream stream(text);
+		std::string line;
+		while (std::getline(stream, line)) {
+			if (line.starts_with("@@")) {
+				const std::string name = line.substr(2);
+				if (name == "container") section = &found.container;
+				else if (name == "config_path") section = &found.config_path;
+				else if (name == "fingerprint") section = &found.fingerprint;
+				else if (name == "excluded") section = &found.excluded;
+				else if (name == "worldserver_conf") section = &found.world_conf;
+				else if (name == "bracket_conf") section = &found.bracket_conf;
+				else section = nullptr;
+				configs_sent = configs_sent || name.ends_with("_conf");
+				continue;
+			}
+			if (section) *section += line + "\n";
+		}
+		for (auto* field : {&found.container, &found.config_path, &found.fingerprint, &found.excluded}) {
+			field->erase(0, field->find_first_not_of(" \t\r\n"));
+			field->erase(field->find_last_not_of(" \t\r\n") + 1);
+		}
+		if (found.container.empty()) return std::nullopt;
+		found.unchanged = !configs_sent;
+		return found;
+	}
+	
+	//* ~/.cache/bottop/discovery-<host>.txt, one per host and configured container
+	static std::filesystem::path discovery_cache_path() {
+		std::filesystem::path dir;
+		if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) dir = xdg;
+		else if (const char* home = std::getenv("HOME"); home && *home) dir = std::filesystem::path(home) / ".cache";
+		else return {};
+		std::string key = config.use_local ? "local" : config.ssh_host;
+		if (!container_discovered && !config.container.empty()) key += "_" + config.container;
+		for (auto& c : key) {
+			if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '-') c = '_';
+		}
+		return dir / "bottop" / ("discovery-" + key + ".txt");
+	}
+	
+	static void write_discovery_cache(const Discovery& found) {
+		const auto path = discovery_cache_path();
+		if (path.empty()) return;
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
+		// Written aside and renamed, so a concurrent start never reads half a file
+		const auto temp = path.string() + ".tmp";
+		{
+			std::ofstream out(temp, std::ios::trunc);
+			if (!out) return;
+			out << "@@container\n" << found.container << "\n@@config_path\n" << found.config_path
+			    << "\n@@fingerprint\n" << found.fingerprint << "\n@@excluded\n" << found.excluded
+			    << "\n@@worldserver_conf\n" << found.world_conf << "@@bracket_conf\n" << found.bracket_conf;
+			if (!out) return;
+		}
+		std::filesystem::rename(temp, path, ec);
+		if (ec) Logger::debug("Discovery cache not written: " + ec.message());
+	}
+	
+	//* Calls on_value(key, value) for each "key = value" line of a .conf text, in a single pass.
+	//* Comments and lines without '=' are skipped, surrounding quotes are dropped from values.
+	template<typename OnValue>
+	static void scan_conf(std::string_view text, OnValue&& on_value) {
+		auto trim = [](std::string_view s) {
+			const size_t first = s.find_first_not_of(" \t\r");
+			if (first == std::string_view::npos) return std::string_view{};
+			return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+		};
+		while (!text.empty()) {
+			const size_t eol = text.find('\n');
+			const std::string_view line = trim(text.substr(0, eol));
+			text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+			if (line.empty() || line[0] == '#') continue;
+			const size_t eq = line.find('=');
+			if (eq == std::string_view::npos) continue;
+			std::string_view value = trim(line.substr(eq + 1));
+			if (value.size() >= 2 && value.front() == '"' && value.back() == '"') value = value.substr(1, value.size() - 2);
+			on_value(trim(line.substr(0, eq)), value);
+		}
+	}
+	
+	//* Whole of text as a number, false and out untouched otherwise
+	template<typename T>
+	static bool conf_number(std::string_view text, T& out) {
+		T value{};
+		const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+		if (ec != std::errc() || end != text.data() + text.size()) return false;
+		out = value;
+		return true;
+	}
+	
+	//* Expected bot counts from the AiPlayerbot lines of worldserver.conf, brackets and continent shares from
+	//* mod_player_bot_level_brackets.conf. Anything missing keeps its default, malformed values are skipped.
+	static void parse_expected_config(const std::string& world_conf, const std::string& bracket_conf) {
+		static const std::unordered_map<std::string_view, std::string_view> continent_names = {
+			{"EasternKingdoms", "Eastern Kingdoms"}, {"Kalimdor", "Kalimdor"}, {"Outland", "Outland"}, {"Northrend", "Northrend"}
+		};
+		std::map<int, int> bracket_min_levels;  // range_num -> min_level
+		std::map<int, int> bracket_max_levels;  // range_num -> max_level
+		std::map<int, double> bracket_percentages;  // range_num -> percentage
+		std::map<int, int> horde_min_levels;  // Horde ranges, same numbering
+		std::map<int, int> horde_max_levels;
+		std::map<std::string, double> continent_percentages;
+		
+		// Only these keys are looked at: AiPlayerbot.{Min,Max}RandomBots, BotContinentPct.<Continent>
+		// and BotLevelBrackets.<Alliance|Horde>.Range<N>.<Lower|Upper|Pct>
+		auto on_value = [&](std::string_view key, std::string_view value) {
+			if (key == "AiPlayerbot.MinRandomBots") conf_number(value, expected_values.bot_min);
+			else if (key == "AiPlayerbot.MaxRandomBots") conf_number(value, expected_values.bot_max);
+			else if (key.starts_with("BotContinentPct.")) {
+				auto name = continent_names.find(key.substr(16));
+				double percent;
+				if (name != continent_names.end() && conf_number(value, percent)) continent_percentages[std::string(name->second)] = percent;
+			}
+			else if (key.starts_with("BotLevelBrackets.")) {
+				key.remove_prefix(17);
+				const bool horde = key.starts_with("Horde.Range");
+				if (!horde && !key.starts_with("Alliance.Range")) return;
+				key.remove_prefix(horde ? 11 : 14);
+				const size_t dot = key.find('.');
+				int range_num;
+				if (dot == std::string_view::npos || !conf_number(key.substr(0, dot), range_num)) return;
+				const std::string_view field = key.substr(dot + 1);
+				int level;
+				if (field == "Lower" && conf_number(value, level)) (horde ? horde_min_levels : bracket_min_levels)[range_num] = level;
+				else if (field == "Upper" && conf_number(value, level)) (horde ? horde_max_levels : bracket_max_levels)[range_num] = level;
+				else if (field == "Pct" && !horde) conf_number(value, bracket_percentages[range_num]);
+			}
+		};
+		scan_conf(world_conf, on_value);
+		if (bracket_conf.empty()) {
+			Logger::error("load_expected_values: Bracket config empty, using defaults");
+			return;
+		}
+		scan_conf(bracket_conf, on_value);
+		
+		// Update continent distribution if found in config
+		if (!continent_percentages.empty()) {
+			expected_values.continent_distribution.clear();
+			for (const auto& pair : continent_percentages) {
+				expected_values.continent_distribution.push_back({
+					pair.first,  // name
+					0,           // count (will be filled during collection)
+					pair.second  // percent
+				});
+			}
+			Logger::error("load_expected_values: Loaded " + std::to_string(continent_percentages.size()) + " continent percentages from config");
+		}
+		
+		// Build bracket definitions from parsed values
+		if (!bracket_min_levels.empty() && !bracket_max_levels.empty()) {
+			expected_values.bracket_definitions.clear();
+			expected_values.level_distribution.clear();
+			
+			// Find the maximum bracket number
+			int max_bracket = 0;
+			for (const auto& pair : bracket_min_levels) {
+				max_bracket = std::max(max_bracket, pair.first);
+			}
+			
+			
+			// Build brackets in order
+			for (int i = 1; i <= max_bracket; i++) {
+				if (bracket_min_levels.count(i) && bracket_max_levels.count(i)) {
+					int min_level = bracket_min_levels[i];
+					int max_level = bracket_max_levels[i];
+					double percent = bracket_percentages.count(i) ? bracket_percentages[i] : 0.0;
+					
+					
+					expected_values.bracket_definitions.push_back({min_level, max_level});
+					
+					// Format range consistently with BracketDefinition constructor
+					std::string range_str;
+					if (min_level == max_level) {
+						range_str = std::to_string(min_level);  // "60"
+					} else {
+						range_str = std::to_string(min_level) + "-" + std::to_string(max_level);  // "1-9"
+					}
+					
+					expected_values.level_distribution.push_back({
+						range_str,
+						0,
+						percent
+					});
+				}
+			}
+			
+			// Horde brackets are only kept when they differ, otherwise both factions share one layout
+			std::vector<BracketDefinition> horde;
+			for (const auto& [range_num, min_level] : horde_min_levels) {
+				if (horde_max_levels.count(range_num)) horde.push_back({min_level, horde_max_levels[range_num]});
+			}
+			bool same_layout = horde.size() == expected_values.bracket_definitions.size() &&
+				std::equal(horde.begin(), horde.end(), expected_values.bracket_definitions.begin(),
+					[](const BracketDefinition& a, const BracketDefinition& b) {
+						return a.min_level == b.min_level && a.max_level == b.max_level;
+					});
+			if (!horde.empty() && !same_layout) {
+				expected_values.horde_bracket_definitions = std::move(horde);
+				Logger::info("load_expected_values: Horde uses its own " +
+					std::to_string(expected_values.horde_bracket_definitions.size()) + " brackets");
+			}
+			
+			Logger::error("load_expected_values: Loaded " + std::to_string(expected_values.bracket_definitions.size()) + " brackets from remote config");
+		} else {
+			Logger::error("load_expected_values: No brackets parsed from config, using defaults");
+		}
 		
+	}
+	
+	//* Use what discovery found: fill in the container and config path when they were not configured, hand the
+	//* excluded accounts to the query and parse the expected values
+	static void apply_discovery(const Discovery& found) {
+		if (config.container.empty() || container_discovered) {
+			container_discovered = true;
+			config.container = found.container;
+		}
+		if (config.config_path.empty() || config_path_discovered) {
+			config_path_discovered = true;
+			config.config_path = found.config_path;
+		}
+		if (query && !found.excluded.empty() && found.excluded != "NULL") query->set_excluded_accounts(found.excluded);
+		try {
+			parse_expected_config(found.world_conf, found.bracket_conf);
+		} catch (const std::exception& e) {
+			Logger::error("load_expected_values: Failed to parse remote config: " + std::string(e.what()));
+		}
+	}
+	
+	static void set_default_expected_values() {
 		// Set default brackets (8 brackets for WotLK)
 		expected_values.bracket_definitions = {
 			{1, 9}, {10, 19}, {20, 29}, {30, 39},
 			{40, 49}, {50, 59}, {60, 60}, {61, 69},
 			{70, 70}, {71, 79}, {80, 80}
 		};
+		expected_values.horde_bracket_definitions.clear();
 		
 		// Set default percentages
 		// Set default percentages
@@ -1844,355 +3864,97 @@ namespace AzerothCore {
 			{"Northrend", 0, 5.0}
 		};
 		
-	expected_values.loaded = true;
-	
-	debug_log << "Set 8 default brackets" << std::endl;
-	Logger::error("load_expected_values: Set 8 default brackets");
-	
-	// Check if SSH is available at all
-	if (!executor || !executor->is_connected()) {
-		debug_log << "No SSH connection available - ssh=" << (executor ? "yes" : "no") 
-		          << ", connected=" << ((executor && executor->is_connected()) ? "yes" : "no") << std::endl;
-		debug_log.close();
-		Logger::error("load_expected_values: No SSH connection available, using defaults");
-		return;
+		expected_values.loaded = true;
 	}
 	
-	// Auto-discover container name if not manually configured
-	if (config.container.empty()) {
-		debug_log << "Container not configured, attempting auto-discovery..." << std::endl;
-		Logger::error("load_expected_values: Container not configured, attempting auto-discovery");
-		
-		// Try multiple patterns to find the worldserver container
-		std::vector<std::string> container_patterns = {
-			"docker ps --filter 'name=ac-worldserver' --format '{{.Names}}' | head -1",
-			"docker ps --filter 'name=worldserver' --format '{{.Names}}' | grep -i ac | head -1",
-			"docker ps --format '{{.Names}}' | grep -i worldserver | head -1",
-			"docker ps --format '{{.Names}}' | grep 'ac-' | head -1"
-		};
-		
-		for (const auto& cmd : container_patterns) {
-			try {
-				debug_log << "Trying pattern: " << cmd << std::endl;
-				std::string result = executor->execute(cmd);
-				
-				// Trim whitespace and newlines
-				result.erase(0, result.find_first_not_of(" \t\r\n"));
-				result.erase(result.find_last_not_of(" \t\r\n") + 1);
-				
-				if (!result.empty() && result.find("Error") == std::string::npos) {
-					config.container = result;
-					debug_log << "Auto-discovered container: " << config.container << std::endl;
-					Logger::error("load_expected_values: Auto-discovered container: " + config.container);
-					break;
-				}
-			} catch (const std::exception& e) {
-				debug_log << "Pattern failed: " << e.what() << std::endl;
-				continue;
-			}
-		}
-		
-		if (config.container.empty()) {
-			debug_log << "Failed to auto-discover container, using defaults" << std::endl;
-			debug_log.close();
-			Logger::error("load_expected_values: Failed to auto-discover container, using defaults");
-			return;
-		}
-	} else {
-		debug_log << "Using manually configured container: " << config.container << std::endl;
-		Logger::error("load_expected_values: Using manually configured container: " + config.container);
+	//* Start from the discovery cache of an earlier run, so the first frame needs no round trip.
+	//* The first cycle revalidates it. False when there is none.
+	static bool load_cached_discovery() {
+		const auto path = discovery_cache_path();
+		if (path.empty()) return false;
+		std::ifstream in(path);
+		if (!in) return false;
+		std::ostringstream text;
+		text << in.rdbuf();
+		auto found = parse_discovery(text.str());
+		if (!found) return false;
+		
+		set_default_expected_values();
+		apply_discovery(*found);
+		last_discovery = std::move(*found);
+		discovery_unverified = true;
+		Logger::info("Warm start from " + path.string() + ", container " + config.container);
+		return true;
 	}
 	
-	// Auto-discover config path if not manually configured
-	if (config.config_path.empty()) {
-		debug_log << "Config path not configured, attempting auto-discovery..." << std::endl;
-		Logger::error("load_expected_values: Config path not configured, attempting auto-discovery");
-		
-		// Try common paths in order of likelihood
-		std::vector<std::string> config_paths = {
-			"/azerothcore/env/dist/etc/worldserver.conf",
-			"/etc/worldserver.conf",
-			"/opt/azerothcore/etc/worldserver.conf",
-			"/azerothcore/etc/worldserver.conf"
-		};
-		
-		for (const auto& path : config_paths) {
-			try {
-				std::string test_cmd = "docker exec " + config.container + " test -f " + path + " && echo found";
-				debug_log << "Testing path: " << path << std::endl;
-				std::string result = executor->execute(test_cmd);
-				
-				if (result.find("found") != std::string::npos) {
-					config.config_path = path;
-					debug_log << "Auto-discovered config path: " << config.config_path << std::endl;
-					Logger::error("load_expected_values: Auto-discovered config path: " + config.config_path);
-					break;
-				}
-			} catch (const std::exception& e) {
-				debug_log << "Path test failed: " << e.what() << std::endl;
-				continue;
-			}
-		}
-		
-		if (config.config_path.empty()) {
-			debug_log << "Failed to auto-discover config path, using defaults" << std::endl;
-			debug_log.close();
-			Logger::error("load_expected_values: Failed to auto-discover config path, using defaults");
+	void load_expected_values() {
+		Logger::error("load_expected_values: === STARTING BRACKET CONFIG LOAD ===");
+		if (!executor || !executor->is_connected()) {
+			// Whatever was loaded last, from the cache or the server, stays until it can be checked
+			if (!expected_values.loaded) set_default_expected_values();
+			Logger::error("load_expected_values: No SSH connection available");
 			return;
 		}
-	} else {
-		debug_log << "Using manually configured config path: " << config.config_path << std::endl;
-		Logger::error("load_expected_values: Using manually configured config path: " + config.config_path);
-	}
-		
-		debug_log << "Starting bracket config load from container: " << config.container << std::endl;
-		Logger::error("load_expected_values: Starting bracket config load from container: " + config.container);
 		
+		std::string output;
 		try {
-			debug_log << "About to read main config file from: " << config.config_path << std::endl;
-			Logger::error("load_expected_values: About to read main config file");
-			
-			// Read main config file from container
-			std::string cmd = "docker exec " + config.container + " cat " + config.config_path;
-			debug_log << "Executing command: " << cmd << std::endl;
-			std::string config_content = executor->execute(cmd);
-			
-			debug_log << "Got config content, length=" << config_content.length() << std::endl;
-			Logger::error("load_expected_values: Got config content, length=" + std::to_string(config_content.length()));
-			
-			if (config_content.empty()) {
-				debug_log << "Config file empty, using defaults" << std::endl;
-				debug_log.close();
-				Logger::error("load_expected_values: Config file empty, using defaults");
-				return;
-			}
-			
-			// Parse config file line by line
-			std::istringstream stream(config_content);
-			std::string line;
-			
-			while (std::getline(stream, line)) {
-				// Skip comments and empty lines
-				if (line.empty() || line[0] == '#') continue;
-				
-				// Look for PlayerBot configuration
-				if (line.find("AiPlayerbot.MinRandomBots") != std::string::npos) {
-					size_t eq_pos = line.find('=');
-					if (eq_pos != std::string::npos) {
-						std::string value = line.substr(eq_pos + 1);
-						value.erase(0, value.find_first_not_of(" \t"));
-						value.erase(value.find_last_not_of(" \t\r\n") + 1);
-						expected_values.bot_min = std::stoi(value);
-					}
-				}
-				else if (line.find("AiPlayerbot.MaxRandomBots") != std::string::npos) {
-					size_t eq_pos = line.find('=');
-					if (eq_pos != std::string::npos) {
-						std::string value = line.substr(eq_pos + 1);
-						value.erase(0, value.find_first_not_of(" \t"));
-						value.erase(value.find_last_not_of(" \t\r\n") + 1);
-						expected_values.bot_max = std::stoi(value);
-					}
-				}
-			}
-			
-			// Read level bracket configuration file from container
-			std::string bracket_config_path = "/azerothcore/env/dist/etc/modules/mod_player_bot_level_brackets.conf";
-			std::string bracket_cmd = "docker exec " + config.container + " cat " + bracket_config_path;
-			debug_log << "About to execute bracket config command: " << bracket_cmd << std::endl;
-			std::string bracket_content = executor->execute(bracket_cmd);
-			
-			debug_log << "Got bracket content, length=" << bracket_content.length() << std::endl;
-			
-			if (bracket_content.empty()) {
-				debug_log << "Bracket config empty, using defaults" << std::endl;
-				debug_log.close();
-				Logger::error("load_expected_values: Bracket config empty, using defaults");
-				return;
-			}
-			
-			Logger::error("load_expected_values: Got bracket config content, length=" + std::to_string(bracket_content.length()));
-			
-			// Parse bracket definitions and percentages
-			// Format: BotLevelBrackets.Alliance.RangeX.Lower/Upper/Pct
-			std::map<int, int> bracket_min_levels;  // range_num -> min_level
-			std::map<int, int> bracket_max_levels;  // range_num -> max_level
-			std::map<int, double> bracket_percentages;  // range_num -> percentage
-			
-			std::istringstream bracket_stream(bracket_content);
-			std::string bracket_line;
-			
-			while (std::getline(bracket_stream, bracket_line)) {
-				// Skip comments and empty lines
-				if (bracket_line.empty() || bracket_line[0] == '#') continue;
-				
-				// Look for BotLevelBrackets.Alliance.RangeX.Lower
-				if (bracket_line.find("BotLevelBrackets.Alliance.Range") != std::string::npos &&
-				    bracket_line.find(".Lower") != std::string::npos) {
-					size_t eq_pos = bracket_line.find('=');
-					if (eq_pos != std::string::npos) {
-						std::string value = bracket_line.substr(eq_pos + 1);
-						value.erase(0, value.find_first_not_of(" \t"));
-						value.erase(value.find_last_not_of(" \t\r\n") + 1);
-						
-						size_t start = bracket_line.find("Range") + 5;
-						size_t end = bracket_line.find(".Lower");
-						if (start < end) {
-							int range_num = std::stoi(bracket_line.substr(start, end - start));
-							bracket_min_levels[range_num] = std::stoi(value);
-						}
-					}
-				}
-				// Look for BotLevelBrackets.Alliance.RangeX.Upper
-				else if (bracket_line.find("BotLevelBrackets.Alliance.Range") != std::string::npos &&
-				         bracket_line.find(".Upper") != std::string::npos) {
-					size_t eq_pos = bracket_line.find('=');
-					if (eq_pos != std::string::npos) {
-						std::string value = bracket_line.substr(eq_pos + 1);
-						value.erase(0, value.find_first_not_of(" \t"));
-						value.erase(value.find_last_not_of(" \t\r\n") + 1);
-						
-						size_t start = bracket_line.find("Range") + 5;
-						size_t end = bracket_line.find(".Upper");
-						if (start < end) {
-							int range_num = std::stoi(bracket_line.substr(start, end - start));
-							bracket_max_levels[range_num] = std::stoi(value);
-						}
-					}
-				}
-				// Look for BotLevelBrackets.Alliance.RangeX.Pct
-				else if (bracket_line.find("BotLevelBrackets.Alliance.Range") != std::string::npos &&
-				         bracket_line.find(".Pct") != std::string::npos) {
-					size_t eq_pos = bracket_line.find('=');
-					if (eq_pos != std::string::npos) {
-						std::string value = bracket_line.substr(eq_pos + 1);
-						value.erase(0, value.find_first_not_of(" \t"));
-						value.erase(value.find_last_not_of(" \t\r\n") + 1);
-						
-						size_t start = bracket_line.find("Range") + 5;
-						size_t end = bracket_line.find(".Pct");
-						if (start < end) {
-							int range_num = std::stoi(bracket_line.substr(start, end - start));
-							bracket_percentages[range_num] = std::stod(value);
-						}
-					}
-				}
-			}
-			
-			// Parse continent percentages
-			// Format: BotContinentPct.EasternKingdoms = 40.0
-			std::map<std::string, double> continent_percentages;
-			
-			std::istringstream continent_stream(bracket_content);
-			std::string continent_line;
-			
-			while (std::getline(continent_stream, continent_line)) {
-				// Skip comments and empty lines
-				if (continent_line.empty() || continent_line[0] == '#') continue;
-				
-				// Look for BotContinentPct.ContinentName
-				if (continent_line.find("BotContinentPct.") != std::string::npos) {
-					size_t eq_pos = continent_line.find('=');
-					if (eq_pos != std::string::npos) {
-						std::string value = continent_line.substr(eq_pos + 1);
-						value.erase(0, value.find_first_not_of(" \t"));
-						value.erase(value.find_last_not_of(" \t\r\n") + 1);
-						
-						size_t start = continent_line.find("BotContinentPct.") + 16;
-						size_t end = eq_pos;
-						if (start < end) {
-							std::string continent_key = continent_line.substr(start, end - start);
-							continent_key.erase(0, continent_key.find_first_not_of(" \t"));
-							continent_key.erase(continent_key.find_last_not_of(" \t") + 1);
-							
-							// Map config keys to continent display names
-							std::string continent_name;
-							if (continent_key == "EasternKingdoms") continent_name = "Eastern Kingdoms";
-							else if (continent_key == "Kalimdor") continent_name = "Kalimdor";
-							else if (continent_key == "Outland") continent_name = "Outland";
-							else if (continent_key == "Northrend") continent_name = "Northrend";
-							else continue;  // Unknown continent
-							
-							continent_percentages[continent_name] = std::stod(value);
-						}
-					}
-				}
-			}
-			
-			// Update continent distribution if found in config
-			if (!continent_percentages.empty()) {
-				expected_values.continent_distribution.clear();
-				for (const auto& pair : continent_percentages) {
-					expected_values.continent_distribution.push_back({
-						pair.first,  // name
-						0,           // count (will be filled during collection)
-						pair.second  // percent
-					});
-				}
-				Logger::error("load_expected_values: Loaded " + std::to_string(continent_percentages.size()) + " continent percentages from config");
-			}
-			
-			// Build bracket definitions from parsed values
-			if (!bracket_min_levels.empty() && !bracket_max_levels.empty()) {
-				debug_log << "Building brackets from parsed data, found " << bracket_min_levels.size() << " min levels" << std::endl;
-				expected_values.bracket_definitions.clear();
-				expected_values.level_distribution.clear();
-				
-				// Find the maximum bracket number
-				int max_bracket = 0;
-				for (const auto& pair : bracket_min_levels) {
-					max_bracket = std::max(max_bracket, pair.first);
-				}
-				
-				debug_log << "Max bracket number: " << max_bracket << std::endl;
-				
-				// Build brackets in order
-				for (int i = 1; i <= max_bracket; i++) {
-					if (bracket_min_levels.count(i) && bracket_max_levels.count(i)) {
-						int min_level = bracket_min_levels[i];
-						int max_level = bracket_max_levels[i];
-						double percent = bracket_percentages.count(i) ? bracket_percentages[i] : 0.0;
-						
-						debug_log << "  Bracket " << i << ": " << min_level << "-" << max_level << " (" << percent << "%)" << std::endl;
-						
-						expected_values.bracket_definitions.push_back({min_level, max_level});
-						
-						// Format range consistently with BracketDefinition constructor
-						std::string range_str;
-						if (min_level == max_level) {
-							range_str = std::to_string(min_level);  // "60"
-						} else {
-							range_str = std::to_string(min_level) + "-" + std::to_string(max_level);  // "1-9"
-						}
-						
-						expected_values.level_distribution.push_back({
-							range_str,
-							0,
-							percent
-						});
-					}
-				}
-				
-				debug_log << "Final bracket count: " << expected_values.bracket_definitions.size() << std::endl;
-				debug_log.close();
-				Logger::error("load_expected_values: Loaded " + std::to_string(expected_values.bracket_definitions.size()) + " brackets from remote config");
-			} else {
-				debug_log << "No brackets parsed (min_levels=" << bracket_min_levels.size() << ", max_levels=" << bracket_max_levels.size() << ")" << std::endl;
-				debug_log.close();
-				Logger::error("load_expected_values: No brackets parsed from config, using defaults");
-			}
-			
+			const bool with_accounts = last_discovery.excluded.empty() || time_ms() >= next_accounts_time;
+			output = executor->execute(discovery_script(last_discovery, with_accounts), cycle_cancel);
+			if (with_accounts) next_accounts_time = time_ms() + ACCOUNTS_TTL_MS;
 		} catch (const std::exception& e) {
-			debug_log << "Exception in load_expected_values: " << e.what() << std::endl;
-			debug_log.close();
-			Logger::error("load_expected_values: Failed to parse remote config: " + std::string(e.what()));
-			// Keep defaults
+			Logger::error("load_expected_values: Discovery failed: " + std::string(e.what()));
 		}
-		
-		debug_log.close();
+		auto found = parse_discovery(output);
+		if (!found) {
+			if (!expected_values.loaded) set_default_expected_values();
+			Logger::error("load_expected_values: Failed to auto-discover container, keeping current values");
+			return;
+		}
+		discovery_unverified = false;
+		
+		// Unchanged files and accounts not due were not sent again
+		if (found->unchanged && found->fingerprint == last_discovery.fingerprint) {
+			found->world_conf = last_discovery.world_conf;
+			found->bracket_conf = last_discovery.bracket_conf;
+		}
+		if (found->excluded.empty()) found->excluded = last_discovery.excluded;
+		const bool changed = found->container != last_discovery.container || found->config_path != last_discovery.config_path
+			|| found->fingerprint != last_discovery.fingerprint || found->excluded != last_discovery.excluded;
+		const std::string previous_container = config.container;
+		set_default_expected_values();
+		apply_discovery(*found);
+		// The query runs its commands in the container it was made with
+		if (query && config.container != previous_container) {
+			Logger::info("Container is now " + config.container + ", recreating the query");
+			query = std::make_unique<Query>(*executor, config, nullptr, "main|", cycle_cancel);
+			if (!found->excluded.empty() && found->excluded != "NULL") query->set_excluded_accounts(found->excluded);
+			bot_list.attach(executor.get(), config);
+		}
+		Logger::error("load_expected_values: Container " + config.container + ", config " + config.config_path
+			+ (found->unchanged ? ", unchanged" : ""));
+		if (changed) write_discovery_cache(*found);
+		last_discovery = std::move(*found);
 	}
 	
 	void cleanup() {
+		// Every thread is told first so they wind down together, in-flight commands and
+		// commands waiting for a connection end within tens of ms, the joins never wait on the network
+		{
+			std::lock_guard lock(collector_mutex);
+			collector_stopping = true;
+			cycle_stop.request_stop();
+		}
+		collector_cv.notify_all();
+		realm_watch.request_stop();
+		bot_list.request_stop();
+		if (collector.joinable()) collector.join();
+		collector_stopping = false;
+		cycle_stop = std::stop_source();
+		cycle_cancel = Cancel();
+		
+		realm_watch.stop();
+		bot_list.stop();
+		query_cache.clear();
 		query.reset();
 		executor.reset();
 		active = false;
@@ -2202,6 +3964,7 @@ namespace AzerothCore {
 		// This will be implemented to return formatted box content for btop display
 		// For now, return a placeholder
 		std::ostringstream out;
+		const auto data = snapshot();
 		
 		if (!enabled) {
 			out << "AzerothCore Monitor: Disabled";
@@ -2210,30 +3973,30 @@ namespace AzerothCore {
 		
 		if (!active) {
 			out << "AzerothCore Monitor: Not connected";
-			if (!current_data.error.empty()) {
-				out << "\nError: " << current_data.error;
+			if (!data->error.empty()) {
+				out << "\nError: " << data->error;
 			}
 			return out.str();
 		}
 		
 		out << "AzerothCore Bot Monitor\n";
 		out << "======================\n";
-		out << "Total Bots: " << current_data.stats.total << "\n";
+		out << "Total Bots: " << data->stats.total << "\n";
 		out << "Uptime: " << std::fixed << std::setprecision(1) 
-			<< current_data.stats.uptime_hours << " hours\n";
+			<< data->stats.uptime_hours << " hours\n";
 		out << "Update Time: " << std::fixed << std::setprecision(1) 
-			<< current_data.stats.update_time_avg << " ms\n\n";
+			<< data->stats.update_time_avg << " ms\n\n";
 		
-		if (!current_data.continents.empty()) {
+		if (!data->continents.empty()) {
 			out << "Continents:\n";
-			for (const auto& c : current_data.continents) {
+			for (const auto& c : data->continents) {
 				out << "  " << c.name << ": " << c.count 
 					<< " (" << std::fixed << std::setprecision(1) << c.percent << "%)\n";
 			}
 		}
 		
-		if (!current_data.error.empty()) {
-			out << "\nError: " << current_data.error;
+		if (!data->error.empty()) {
+			out << "\nError: " << data->error;
 		}
 		
 		return out.str();
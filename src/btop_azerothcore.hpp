@@ -18,13 +18,27 @@ tab-size = 4
 
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <deque>
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <cstdint>
 #include <unordered_map>
 
+#include "btop_advisor.hpp"
+#include "btop_name_index.hpp"
+
 namespace AzerothCore {
 
 	//* Hardcoded WotLK Zone ID to Name mapping
@@ -305,6 +319,49 @@ namespace AzerothCore {
 		return {"Unknown", "", 1, 80};  // Default for unknown zones
 	}
 
+	//* Class name from characters.class
+	inline std::string class_name(int class_id) {
+		switch (class_id) {
+			case 1: return "Warrior";
+			case 2: return "Paladin";
+			case 3: return "Hunter";
+			case 4: return "Rogue";
+			case 5: return "Priest";
+			case 6: return "Death Knight";
+			case 7: return "Shaman";
+			case 8: return "Mage";
+			case 9: return "Warlock";
+			case 11: return "Druid";
+			default: return "Class " + std::to_string(class_id);
+		}
+	}
+
+	//* Race name from characters.race
+	inline std::string race_name(int race) {
+		switch (race) {
+			case 1: return "Human";
+			case 2: return "Orc";
+			case 3: return "Dwarf";
+			case 4: return "Night Elf";
+			case 5: return "Undead";
+			case 6: return "Tauren";
+			case 7: return "Gnome";
+			case 8: return "Troll";
+			case 10: return "Blood Elf";
+			case 11: return "Draenei";
+			default: return "Race " + std::to_string(race);
+		}
+	}
+
+	//* 0 Alliance, 1 Horde, 2 neither
+	inline int race_faction(int race) {
+		switch (race) {
+			case 1: case 3: case 4: case 7: case 11: return 0;
+			case 2: case 5: case 6: case 8: case 10: return 1;
+			default: return 2;
+		}
+	}
+
 	//* Format uptime as 2-digit display (09s, 01m, 2h, 01d)
 	inline std::string format_uptime(double uptime_hours) {
 		int total_seconds = (int)(uptime_hours * 3600);
@@ -346,6 +403,13 @@ namespace AzerothCore {
 		std::string ra_password = "";  // RA (Remote Administrator) console password
 		int update_interval = 5;
 		bool use_local = false;  // If true, use local Docker instead of SSH
+		int rtt_budget_ms = 0;   // Query round-trip time bottop may spend per minute (0 = unlimited)
+		int sample_margin = 0;   // Target 95% margin of error for sampled distributions, in 0.1% (0 = exact)
+		int table_limit_mb = 10240;  // Table size to project growth towards (0 = no projection)
+		std::string worldserver_db_user = "acore";  // Whose transactions the lock monitor shows (empty = everyone but bottop)
+		std::string realms = "";  // Other realms for the overview, "name|host|container[|db_host]" separated by spaces
+		int eco_idle_s = 0;       // Seconds without input before eco mode (0 = never eco)
+		int eco_ms = 60000;       // Collection interval while in eco mode
 		
 		// InfluxDB metrics (optional - if not set, falls back to MySQL query timing)
 		std::string influx_host = "";  // e.g., "127.0.0.1"
@@ -415,6 +479,7 @@ namespace AzerothCore {
 		std::string name;
 		int count = 0;
 		double percent = 0.0;
+		double margin = 0.0;  // 95% confidence half-width in percentage points, 0 when counted exactly
 	};
 	
 	//* Faction distribution
@@ -422,13 +487,60 @@ namespace AzerothCore {
 		std::string name;  // Alliance, Horde, Neutral
 		int count = 0;
 		double percent = 0.0;
+		double margin = 0.0;  // 95% confidence half-width in percentage points, 0 when counted exactly
 	};
 
-	//* Zone detail (breakdown by level/class when expanded)
-	struct ZoneDetail {
-		std::string label;      // "Level 10-20", "Warrior", etc.
-		int count = 0;
-		double percent = 0.0;
+	//* Online bot counts per level and faction, the only level data asked of the server.
+	//* Bracket layouts are derived locally from prefix sums, so changing them needs no new query.
+	class LevelHistogram {
+	public:
+		static constexpr int MAX_LEVEL = 80;
+		enum Side : uint8_t { ALL, ALLIANCE, HORDE };
+
+		void add(int level, int total, int alliance, int horde);  // Levels outside 1-MAX_LEVEL only count towards total()
+		void merge(const LevelHistogram& other);
+		void finalize();  // Turn the per-level counts into prefix sums, call once after the last add()
+		int count(int min_level, int max_level, Side side = ALL) const;
+		int total(Side side = ALL) const { return totals_[side]; }
+		int min_level() const { return min_level_; }
+		int max_level() const { return max_level_; }
+		bool empty() const { return totals_[ALL] == 0; }
+
+	private:
+		std::array<std::array<int, MAX_LEVEL + 1>, 3> sums_{};  // sums_[side][n]: bots of level 1..n once finalized
+		std::array<int, 3> totals_{};
+		int min_level_ = 0;
+		int max_level_ = 0;
+		bool finalized_ = false;
+	};
+
+	//* Online bots counted by zone × level × race × class, one dense block per zone with level innermost.
+	//* finalize() turns the level axis into prefix sums, so any level range of a cell is two reads
+	//* and a roll-up is one linear pass over the counts.
+	class BotCube {
+	public:
+		static constexpr int MAX_LEVEL = LevelHistogram::MAX_LEVEL;
+		static constexpr int RACES = 11;    // Race ids 1-11
+		static constexpr int CLASSES = 11;  // Class ids 1-11
+
+		void add(int zone_id, int level, int race, int class_id, int count);  // Ids or levels out of range are dropped
+		void finalize();  // Call once after the last add()
+		const std::vector<int>& zones() const { return zone_ids_; }
+		//* Bots in zones()[zone] of race and class within a level range
+		int count(size_t zone, int race, int class_id, int min_level = 1, int max_level = MAX_LEVEL) const;
+		int total() const { return total_; }
+		bool empty() const { return total_ == 0; }
+
+	private:
+		size_t cell(size_t zone, int race, int class_id) const {
+			return ((zone * RACES + race - 1) * CLASSES + class_id - 1) * (MAX_LEVEL + 1);
+		}
+
+		std::vector<int> zone_ids_;
+		std::unordered_map<int, size_t> zone_index_;
+		std::vector<int> counts_;  // [zone][race][class][level], level 0 is the zero of the prefix sums
+		int total_ = 0;
+		bool finalized_ = false;
 	};
 
 	//* Zone health information
@@ -443,11 +555,23 @@ namespace AzerothCore {
 		int actual_min = 0;       // Actual lowest bot level in zone (from database)
 		int actual_max = 0;       // Actual highest bot level in zone (from database)
 		double alignment = 0.0;   // % of bots within expected level range
-		std::vector<ZoneDetail> details;  // Level/class breakdown (loaded on demand when expanded)
+		double alignment_margin = 0.0;  // 95% confidence half-width of alignment when sampled
+		LevelHistogram levels;    // Per-level counts, alignment is derived from this
 		
 		bool is_healthy() const { return alignment >= 80.0; }
 	};
 
+	//* One online bot in a zone drill-down
+	struct BotRow {
+		int guid = 0;
+		std::string name;
+		int level = 0;
+		int class_id = 0;
+		int race = 0;
+		int account = 0;
+		int deviation = 0;  // Levels outside the zone's expected range, 0 when inside
+	};
+
 	//* Level bracket definition (min-max level range)
 	struct BracketDefinition {
 		int min_level;
@@ -470,8 +594,14 @@ namespace AzerothCore {
 		std::string range;
 		int count = 0;
 		double percent = 0.0;
+		double margin = 0.0;  // 95% confidence half-width in percentage points, 0 when counted exactly
 	};
 
+	//* Counts for each bracket of a layout, percentages are of all bots in the histogram.
+	//* Bots outside every bracket are reported as "Other".
+	std::vector<LevelBracket> rebin(const LevelHistogram& histogram, const std::vector<BracketDefinition>& brackets,
+		LevelHistogram::Side side = LevelHistogram::ALL);
+
 	//* Server status enumeration
 	enum class ServerStatus {
 		ONLINE,      // Server is running normally
@@ -481,14 +611,212 @@ namespace AzerothCore {
 		ERROR        // Error connecting or querying
 	};
 	
-	//* Complete server data snapshot
+	//* Round-trip budget usage for display
+	struct RttBudgetStats {
+		uint64_t used_ms = 0;     // Round-trip time of bottop's queries in the last 60 seconds
+		uint64_t limit_ms = 0;    // Configured ceiling per minute (0 = unlimited)
+		uint64_t shed = 0;        // Queries dropped by admission control since start
+		uint64_t spacing_ms = 0;  // Current minimum spacing between full collection cycles
+	};
+
+	//* Executor request counters
+	struct ExecutorStats {
+		uint64_t requests = 0;
+		uint64_t hedged = 0;      // Duplicates issued after a request passed its adaptive p95
+		uint64_t hedge_wins = 0;  // Duplicates that answered before the original
+		uint64_t timeouts = 0;    // Requests abandoned after the adaptive timeout
+	};
+
+	//* Systematic sample of online bots by guid: rows with guid % modulus == residue.
+	//* The residue rotates every cycle so no fixed subset of bots is favoured.
+	struct SamplePlan {
+		int modulus = 1;      // 1 = exact, every bot counted
+		int residue = 0;
+		int population = 0;   // Online bots when the plan was made
+		int sampled = 0;      // Bots in the sample, filled in by the zone histogram query
+
+		bool active() const { return modulus > 1; }
+		double scale() const { return sampled > 0 ? (double)population / sampled : 1.0; }
+	};
+
+	//* Sample size for a 95% margin of error (fraction, 0.005 = +-0.5%) at worst case p = 0.5,
+	//* with finite population correction
+	int sample_size(double margin, int population);
+
+	//* 95% confidence half-width in percentage points for hits out of a sample drawn from population
+	double margin_of_error(int hits, int sample, int population);
+
+	//* Server-maintained summary of online bots per (zone, map, race, class, level), refreshed by a MySQL EVENT.
+	//* While it is installed, fresh and agrees with the periodic exact count, a collection cycle reads
+	//* this one small row set instead of aggregating characters.
+	struct SummaryStatus {
+		bool installed = false;  // Table and refresh event exist
+		bool active = false;     // Read instead of characters this cycle
+		int age_s = 0;           // Seconds since the event last refreshed it
+		int drift = 0;           // Summary total minus the last exact count
+		std::string reason;      // Why an installed summary is not being read
+	};
+
+	//* Size of one table of the character database, with its growth over the sampled window
+	struct TableSize {
+		std::string name;
+		int64_t rows = 0;              // InnoDB estimate
+		uint64_t data_bytes = 0;
+		uint64_t index_bytes = 0;
+		double bytes_per_hour = 0.0;   // 0 until there are two samples
+		double rows_per_hour = 0.0;
+		double hours_to_limit = -1.0;  // Projected time until the size limit, 0 when past it, -1 when not growing or no limit
+		
+		uint64_t bytes() const { return data_bytes + index_bytes; }
+	};
+
+	struct TableReport {
+		std::vector<TableSize> tables;  // Fastest growing first
+		size_t samples = 0;             // Size samples behind the growth rates
+		uint64_t window_ms = 0;         // Between the oldest and the newest of them
+		uint64_t limit_bytes = 0;
+	};
+
+	//* Per-table size history in fixed rings, fed by the slow table size collector.
+	//* Rates are least squares slopes over the window, InnoDB sizes grow in extent sized steps.
+	class TableGrowth {
+	public:
+		static constexpr size_t WINDOW = 36;  // Samples kept per table, 6 hours at the default cadence
+
+		void record(uint64_t now_ms, const std::vector<TableSize>& sizes);  // Tables missing from sizes are forgotten
+		TableReport report(uint64_t limit_bytes) const;
+		void clear() { rings_.clear(); }
+
+	private:
+		struct Sample {
+			uint64_t ms = 0;
+			uint64_t bytes = 0;
+			int64_t rows = 0;
+		};
+		struct Ring {
+			std::array<Sample, WINDOW> samples{};
+			size_t next = 0;
+			size_t count = 0;
+			TableSize latest;
+		};
+		std::unordered_map<std::string, Ring> rings_;
+	};
+
+	//* An open InnoDB transaction
+	struct LockTransaction {
+		int thread_id = 0;        // Processlist id
+		int age_s = 0;            // Since the transaction started
+		int64_t rows_locked = 0;
+		std::string state;        // RUNNING, LOCK WAIT, ...
+		std::string query;        // Statement running now, empty between statements
+	};
+
+	//* Statements of one digest in the characters schema during the last interval
+	struct DigestDelta {
+		std::string digest;
+		std::string text;         // Normalized statement, truncated
+		int64_t calls = 0;
+		int64_t ms = 0;           // Total statement time
+	};
+
+	//* Lock waits, long transactions and statement time, read every collection cycle
+	struct LockReport {
+		bool available = false;   // performance_schema was readable this cycle
+		int lock_waits = 0;
+		int longest_wait_s = 0;
+		std::vector<LockTransaction> transactions;  // Longest running first
+		std::vector<DigestDelta> digests;           // Most time during the interval first
+		int64_t statement_ms = 0;                   // All digests of the interval together
+		double interval_s = 0.0;
+	};
+
+	//* Fixed-size history of one health series for sparklines, the oldest sample is overwritten first.
+	//* -1 marks a cycle without a sample, so the series stays on the update-time timeline.
+	class HealthSeries {
+	public:
+		static constexpr size_t SIZE = 300;  // Same length as load_history
+
+		void push(double value) {
+			values_[next_] = value;
+			next_ = (next_ + 1) % SIZE;
+			if (count_ < SIZE) count_++;
+		}
+		size_t size() const { return count_; }
+		//* i = 0 is the oldest sample
+		double operator[](size_t i) const { return values_[(next_ + SIZE - count_ + i) % SIZE]; }
+		double latest() const { return count_ ? (*this)[count_ - 1] : -1.0; }
+
+	private:
+		std::array<double, SIZE> values_{};
+		size_t next_ = 0;
+		size_t count_ = 0;
+	};
+
+	//* MySQL server health from SHOW GLOBAL STATUS deltas, rates are per second over the last interval
+	struct DbHealth {
+		bool available = false;     // Last sample succeeded
+		bool rates = false;         // Two consecutive samples, so the rates below mean something
+		double qps = 0.0;
+		double slow_per_s = 0.0;
+		double hit_pct = 0.0;       // InnoDB buffer pool reads served from memory
+		double reads_per_s = 0.0;   // Rows read
+		double writes_per_s = 0.0;  // Rows inserted, updated and deleted
+		int threads_running = 0;
+		int threads_connected = 0;
+		int max_connections = 0;
+		int64_t uptime_s = 0;
+		HealthSeries qps_history;
+		HealthSeries slow_history;
+		HealthSeries hit_history;
+		HealthSeries reads_history;
+		HealthSeries writes_history;
+		HealthSeries running_history;
+		HealthSeries connected_history;
+	};
+
+	//* Query cache counters for the debug view
+	struct CacheStats {
+		uint64_t hits = 0;        // Fresh entries served
+		uint64_t stale_hits = 0;  // Expired entries served while their refresh was queued
+		uint64_t misses = 0;      // Round trips made
+		uint64_t coalesced = 0;   // Requests that shared another caller's round trip
+	};
+
+	//* Expected values configuration (from server .conf files)
+	struct ExpectedValues {
+		int bot_min = 0;
+		int bot_max = 0;
+		std::vector<LevelBracket> level_distribution;
+		std::vector<Continent> continent_distribution;  // Expected continent distribution from config
+		std::vector<BracketDefinition> bracket_definitions;  // Actual bracket ranges from config (Alliance)
+		std::vector<BracketDefinition> horde_bracket_definitions;  // Horde ranges, empty when the same as Alliance
+		bool loaded = false;
+	};
+
+	//* Overview line of one realm
+	struct RealmSummary {
+		std::string name;
+		std::string host;           // ssh host, "local" for Docker on this machine
+		bool primary = false;       // Shown in the main view, its numbers come from the snapshot instead
+		bool polled = false;        // A poll has finished
+		ServerStatus status = ServerStatus::OFFLINE;
+		int bots = 0;
+		bool perf = false;          // mean_ms and p99_ms are known
+		long long mean_ms = 0;      // Server update time
+		long long p99_ms = 0;
+		std::string error;
+		uint64_t updated_ms = 0;    // When the last poll finished
+	};
+
+	//* Complete server data snapshot. Published ones are immutable and shared between threads.
 	struct ServerData {
 		BotStats stats;
 		OllamaStats ollama;
 		std::vector<Continent> continents;
 		std::vector<Faction> factions;
 		std::vector<Zone> zones;
-		std::vector<LevelBracket> levels;
+		std::vector<LevelBracket> levels;         // Derived from level_histogram with the configured brackets
+		LevelHistogram level_histogram;           // All online bots, sum of the per-zone histograms
 		std::vector<ContainerStatus> containers;  // Docker container statuses
 		std::string timestamp;
 		std::string error;
@@ -496,34 +824,184 @@ namespace AzerothCore {
 		ServerStatus status = ServerStatus::ONLINE;
 		int consecutive_failures = 0;  // Track consecutive query failures
 		double rebuild_progress = 0.0;  // Rebuild progress percentage (0-100)
+		RttBudgetStats budget;          // bottop's own query round trips against the configured budget
+		ExecutorStats executor;         // Hedging and timeout counters of the command executor
+		SamplePlan sample;              // How the distributions were counted this cycle
+		CacheStats cache;               // Query cache counters, shown in debug mode
+		SummaryStatus summary;          // Whether the distributions came from the summary table
+		std::shared_ptr<const BotCube> cube;  // Read with the zone histogram, shared between snapshots; null until then
+		TableReport tables;             // Character database table sizes, sampled on a slow cadence
+		DbHealth health;                // MySQL server status, sampled over a persistent session
+		LockReport locks;               // InnoDB lock waits and statement time of the last interval
+		bool eco = false;               // Collected in eco mode: status and bot count only, the rest carried over
+		std::shared_ptr<const Advisor::Report> advice;  // Index advice run on the collector, null until asked for
+		uint64_t advice_request = 0;    // The request_advice() the advice answers
+		//* Copied in when the snapshot is published, so the UI never reads the collector's state
+		std::deque<long long> load_history;          // Mean server update time per cycle, last 300
+		std::deque<long long> lock_wait_history;     // Same cycles as load_history, -1 where the read was shed
+		std::deque<long long> statement_ms_history;
+		std::deque<bool> eco_history;                // Same cycles as load_history, true where eco mode sampled
+		ExpectedValues expected;
+		std::vector<RealmSummary> realms;            // Configured realms in order, name, host and primary only
 	};
-	
-	//* Expected values configuration (from server .conf files)
-	struct ExpectedValues {
-		int bot_min = 0;
-		int bot_max = 0;
-		std::vector<LevelBracket> level_distribution;
-		std::vector<Continent> continent_distribution;  // Expected continent distribution from config
-		std::vector<BracketDefinition> bracket_definitions;  // Actual bracket ranges from config
-		bool loaded = false;
+
+
+	//* Priority of a query for admission control under the round-trip budget
+	enum class QueryPriority {
+		CRITICAL,  // Always admitted (bot count, account exclusions)
+		NORMAL,    // Shed once the budget is spent (distributions, zones)
+		LOW        // Shed once half the budget is spent (Ollama stats)
+	};
+
+	//* Sliding one-minute account of the round-trip time of bottop's own queries: SSH, docker exec and
+	//* MySQL together. An upper bound on the server time they cost, so the ceiling errs on the safe side.
+	class LoadBudget {
+	public:
+		void set_limit(uint64_t ms_per_minute);
+		void record(uint64_t cost_ms);
+		bool admit(QueryPriority priority);
+		uint64_t full_cycle_spacing(uint64_t cycle_cost_ms);  // Minimum ms between full cycles to stay under the limit
+		uint64_t total();  // Cumulative round-trip time since start, for measuring the cost of a cycle
+		RttBudgetStats stats();
+
+	private:
+		void expire(uint64_t now_ms);
+
+		std::mutex mutex_;
+		std::deque<std::pair<uint64_t, uint64_t>> samples_;  // (timestamp ms, cost ms)
+		uint64_t limit_ms_ = 0;
+		uint64_t window_ms_ = 0;
+		uint64_t total_ms_ = 0;
+		uint64_t shed_ = 0;
+		uint64_t spacing_ms_ = 0;
+	};
+
+	//* Query type of a command: hash of its text with numeric literals collapsed,
+	//* so the same query against different zones shares one latency distribution
+	uint64_t query_kind(const std::string& command);
+
+	//* Rolling per-query-type latency samples for adaptive timeouts and hedging
+	class LatencyTracker {
+	public:
+		static constexpr size_t WINDOW = 64;        // Samples kept per query type
+		static constexpr size_t MIN_SAMPLES = 8;    // Quantiles are unknown below this
+
+		void record(uint64_t kind, uint64_t ms);
+		uint64_t quantile(uint64_t kind, double q);  // 0 when not enough samples
+		uint64_t timeout_ms(uint64_t kind);          // Idle timeout from the observed p99, a timed-out request is recorded at its timeout
+
+	private:
+		struct Ring {
+			std::array<uint32_t, WINDOW> samples{};
+			size_t count = 0;
+			size_t next = 0;
+		};
+		std::mutex mutex_;
+		std::unordered_map<uint64_t, Ring> rings_;
+	};
+
+	struct Cancel;
+
+	//* Result cache under mysql_exec and executor commands, keyed by whitespace-normalized command text.
+	//* An entry is fresh for its TTL and is served stale for as long again while a refresh is queued,
+	//* concurrent requests for a key that is being fetched wait for that one round trip.
+	//* Empty results are never stored, they are what failed or shed commands return.
+	class QueryCache {
+	public:
+		using Fetcher = std::function<std::string(const Cancel&)>;  // Runs the command under the cancel it is given
+		struct Refresh {
+			std::string key;
+			uint64_t ttl_ms;
+			Fetcher fetch;
+		};
+		//* Stale entries served to a caller, its own to refresh. The fetches call back into the caller,
+		//* so the queue lives and dies with it and is drained by the thread that drives it.
+		using Refreshes = std::vector<Refresh>;
+
+		//* ttl_ms = 0 only coalesces. A fetch on a miss runs under cancel, a stale hit queues its refresh on refreshes.
+		std::string get(const std::string& command, uint64_t ttl_ms, Fetcher fetch, const Cancel& cancel, Refreshes& refreshes);
+		void revalidate(Refreshes& refreshes, const Cancel& cancel);  // Run and empty a caller's queued refreshes under cancel
+		void clear();
+		CacheStats stats();
+		static std::string normalize(const std::string& command);
+
+	private:
+		struct Entry {
+			std::string value;
+			uint64_t fetched_ms = 0;
+			bool refresh_queued = false;  // Left set when the queue goes with its owner, the entry then expires
+		};
+		std::string fetch_shared(std::unique_lock<std::mutex>& lock, const std::string& key, uint64_t ttl_ms, const Fetcher& fetch,
+								 const Cancel& cancel);
+
+		std::mutex mutex_;
+		std::unordered_map<std::string, Entry> entries_;
+		std::unordered_map<std::string, std::shared_future<std::string>> in_flight_;
+		CacheStats stats_;
+	};
+
+	//* Stop request and deadline of a piece of collection work, handed down by whoever schedules it.
+	//* Every wait on a command checks it at least every CHECK_MS: the command is ended, its channel
+	//* closed or its process killed, and "" returned as for a timeout.
+	struct Cancel {
+		using Clock = std::chrono::steady_clock;
+		static constexpr std::chrono::milliseconds CHECK_MS{20};
+
+		std::stop_token stop;
+		Clock::time_point deadline = Clock::time_point::max();
+
+		static Cancel within(std::stop_token stop, std::chrono::milliseconds budget) { return {std::move(stop), Clock::now() + budget}; }
+		bool expired() const { return stop.stop_requested() || Clock::now() >= deadline; }
+		//* Time to the deadline, at most cap and zero once expired
+		std::chrono::milliseconds left(std::chrono::milliseconds cap) const {
+			if (expired()) return std::chrono::milliseconds(0);
+			if (deadline == Clock::time_point::max()) return cap;
+			return std::min(cap, std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()));
+		}
+	};
+
+	//* A command kept running and fed requests on stdin, e.g. an interactive mysql client
+	class Session {
+	public:
+		virtual ~Session() = default;
+		//* Send input and return the output up to the line end_marker, which is not included.
+		//* On a timeout, cancel or when the command exited the session is dead and returns "".
+		virtual std::string exchange(const std::string& input, std::string_view end_marker, std::chrono::milliseconds timeout,
+									 const Cancel& cancel = {}) = 0;
+		virtual bool alive() const = 0;
 	};
 
 	//* Command executor interface - can be SSH or local
 	class CommandExecutor {
 	public:
 		virtual ~CommandExecutor() = default;
-		virtual std::string execute(const std::string& command) = 0;
+		virtual std::string execute(const std::string& command, const Cancel& cancel = {}) = 0;
+		//* Start a command that keeps running, nullptr when it could not be started
+		virtual std::unique_ptr<Session> open_session([[maybe_unused]] const std::string& command, [[maybe_unused]] const Cancel& cancel = {}) {
+			return nullptr;
+		}
+		//* execute() through query_cache, a stale hit queues its refresh on refreshes
+		std::string execute_cached(const std::string& command, uint64_t ttl_ms, const Cancel& cancel, QueryCache::Refreshes& refreshes);
 		virtual bool is_connected() const = 0;
 		virtual std::string last_error() const = 0;
+		ExecutorStats stats() const { return {requests_, hedged_, hedge_wins_, timeouts_}; }
+
+	protected:
+		LatencyTracker latency_;
+		std::atomic<uint64_t> requests_{0};
+		std::atomic<uint64_t> hedged_{0};
+		std::atomic<uint64_t> hedge_wins_{0};
+		std::atomic<uint64_t> timeouts_{0};
 	};
 
-	//* Local command executor (uses popen)
+	//* Local command executor, runs commands through /bin/sh
 	class LocalExecutor : public CommandExecutor {
 	public:
 		LocalExecutor() = default;
 		~LocalExecutor() override = default;
 		
-		std::string execute(const std::string& command) override;
+		std::string execute(const std::string& command, const Cancel& cancel = {}) override;
+		std::unique_ptr<Session> open_session(const std::string& command, const Cancel& cancel = {}) override;
 		bool is_connected() const override { return true; }  // Always "connected" for local
 		std::string last_error() const override { return error_; }
 		
@@ -537,56 +1015,242 @@ namespace AzerothCore {
 		SSHClient(const std::string& host);
 		~SSHClient();
 		
-		bool connect();
-		std::string execute(const std::string& command) override;
+		bool connect(const Cancel& cancel = {});
+		std::string execute(const std::string& command, const Cancel& cancel = {}) override;
+		std::unique_ptr<Session> open_session(const std::string& command, const Cancel& cancel = {}) override;
 		bool is_connected() const override;
 		std::string last_error() const override;
 		
 	private:
+		friend class SSHSession;
 		std::string host_;
 		void* session_ = nullptr;  // LIBSSH2_SESSION*
 		int sock_ = -1;
 		std::string error_;
+		std::timed_mutex exec_mutex_;  // libssh2 sessions must not be driven from two threads at once
 	};
 
 	//* Query handler for AzerothCore bot data
 	class Query {
 	public:
-		Query(CommandExecutor& executor, const ServerConfig& config);
+		//* budget defaults to the global load_budget. cache_scope keeps the cache entries of queries
+		//* against another realm apart from identical command lines of this one.
+		Query(CommandExecutor& executor, const ServerConfig& config, LoadBudget* budget = nullptr, std::string cache_scope = "",
+			  Cancel cancel = {});
 		
-		ServerData fetch_all();
-		std::vector<ZoneDetail> fetch_zone_details(int zone_id);  // Fetch level breakdown for a zone
+		//* Stop request and deadline for the commands of everything called from here on. A Query is
+		//* driven by one thread at a time, which sets this before each cycle of work.
+		void set_cancel(Cancel cancel) { cancel_ = std::move(cancel); }
+		//* Refresh the entries this Query was served stale, under its cancel. Called by the thread driving it,
+		//* before the reads of its next cycle of work.
+		void revalidate();
+		//* Excluded account ids found by discovery, saves looking them up on first use
+		void set_excluded_accounts(std::string ids) { excluded_account_ids_ = std::move(ids); }
+		
+		ServerData fetch_all(bool full = true, bool exact = true);  // full=false only refreshes bot stats, exact=false may sample
+		BotStats fetch_bot_stats(bool count = true);  // count=false leaves the bot total to the summary
 		std::pair<bool, double> check_rebuild_status();  // Check if rebuilding and get progress (bool=rebuilding, double=progress 0-100)
 		std::vector<ContainerStatus> fetch_container_statuses();  // Fetch status of all AzerothCore containers
+		std::vector<Advisor::QuerySpec> collection_queries();  // The DB queries of a collection cycle, for the advisor
+		Advisor::Report advise();  // EXPLAIN every collection query and suggest missing indexes
+		std::vector<std::string> summary_ddl();  // Statements creating the summary table and its events
+		bool install_summary();  // Run summary_ddl(), true when the summary is installed afterwards
+		//* One keyset page of a zone's online bots: the next limit guids after after_guid (0 for the first page),
+		//* sorted furthest outside the expected range first. Pages walk the primary key, a deviation order
+		//* across pages would have every page read the whole zone.
+		std::vector<BotRow> fetch_zone_bots(int zone_id, int expected_min, int expected_max, int after_guid, int limit);
+		//* guid, zone and level of every online bot, nullopt when the query was shed or failed
+		std::optional<std::vector<Names::Position>> fetch_online_positions();
+		std::unordered_map<int, std::string> fetch_names(const std::vector<int>& guids);
+		std::vector<TableSize> fetch_table_sizes();  // Empty when shed or failed
+		LockReport fetch_locks();  // Digest times are deltas since the previous call
+		DbHealth fetch_health();   // Samples SHOW GLOBAL STATUS, rates against the previous call
+		void forget_performance();  // Drop the last known "server info" values, after a restart
 		
 	private:
 		CommandExecutor& executor_;  // Changed from ssh_ to executor_
 		ServerConfig config_;
+		LoadBudget& budget_;
+		std::string cache_scope_;
+		Cancel cancel_;
+		QueryCache::Refreshes refresh_;  // Stale entries this Query was served, refreshed by revalidate()
+		ServerPerformance last_perf_;  // Last good "server info", reused between refreshes
+		uint64_t last_perf_ms_ = 0;
 		std::string excluded_account_ids_;  // Cached list of excluded account IDs (e.g., "1,2,3,4")
+		SamplePlan sample_;  // Sampling used by the distribution queries of the current cycle
+		SummaryStatus summary_;
+		uint64_t next_summary_check_ = 0;   // Next look for the summary table and event, the first fetch_all() looks
+		uint64_t next_summary_verify_ = 0;  // Next drift check against an exact count
+		bool summary_ready_ = false;        // Installed, event enabled and event_scheduler ON
+		bool summary_drifted_ = false;      // Last drift check failed, wait for the next one
+		std::unordered_map<std::string, std::pair<int64_t, int64_t>> digest_totals_;  // digest -> cumulative (calls, ms)
+		uint64_t last_locks_ms_ = 0;
+		std::unique_ptr<Session> mysql_session_;  // Persistent client for the health samples
+		DbHealth health_;
+		std::unordered_map<std::string, int64_t> last_status_;  // Counters of the previous health sample
+		uint64_t last_health_ms_ = 0;
 		
-		std::string mysql_exec(const std::string& query);
-		void cache_excluded_accounts();  // Fetch and cache excluded account IDs
+		std::string mysql_exec(const std::string& query, QueryPriority priority = QueryPriority::NORMAL, uint64_t ttl_ms = 0);
+		//* Statements over mysql_session_, opened on first use and reopened after it died. Not cached.
+		std::string mysql_session_exec(const std::string& statements, QueryPriority priority = QueryPriority::LOW);
+		void cache_excluded_accounts();  // Fetch and cache excluded account IDs, on first use unless set
 		std::string get_excluded_accounts_filter();  // Get WHERE clause for excluding accounts
+		std::string get_sample_filter(const std::string& guid_column = "guid");  // " AND guid % m = r" or empty
+		void plan_sample(int population, bool exact);
+		std::string sql_excluded_accounts();
+		std::string sql_bot_count();
+		std::string sql_continents();
+		std::string sql_factions();
+		std::string sql_zone_histogram();
+		std::string sql_summary();
+		void detect_summary();  // Refresh summary_.installed from information_schema
+		bool fetch_summary(ServerData& data);  // Bot total and all distributions from the summary, false if stale or missing
+		bool verify_summary(BotStats& stats);  // Exact count into stats, false and stop reading the summary on drift
+		void apply_sample(ServerData& data);  // Scale counts and attach margins when sampled
 		ServerPerformance fetch_server_performance();  // Fetch real server performance from "server info"
-		BotStats fetch_bot_stats();
+		void count_bots(BotStats& stats);  // Exact online bot count, timed as the query round trip
 		std::vector<Continent> fetch_continents();
 		std::vector<Faction> fetch_factions();
-		std::vector<Zone> fetch_zones();
-		std::vector<LevelBracket> fetch_levels();
+		std::vector<Zone> fetch_zones(LevelHistogram& all_levels, std::shared_ptr<const BotCube>& cube);  // Also sums the per-zone level histograms
 		OllamaStats fetch_ollama_stats();
 	};
 
+	//* Bot list of the expanded zone. Pages are fetched on a worker thread as the view nears the end
+	//* of what is loaded, so a zone holding thousands of bots is never read in full.
+	class BotList {
+	public:
+		static constexpr int PAGE_SIZE = 50;
+		static constexpr size_t PREFETCH_ROWS = 20;  // Ask for the next page when the view is this close to the end
+
+		static constexpr uint64_t PAGE_DEADLINE_MS = 10000;
+
+		//* Read pages from this server, through a Query of the worker's own. The worker replaces its Query before
+		//* the next page, a page in flight on the old one is dropped and fetched again. The old executor has to
+		//* outlive that page, stop() first when it goes away.
+		void attach(CommandExecutor* executor, const ServerConfig& config);
+		void open(int zone_id, int expected_min, int expected_max);  // Switch to a zone and fetch its first page
+		void close();
+		void request_stop();  // Cancel the worker without waiting for it, stop() joins it
+		void stop();  // Cancel and join the worker and drop its Query, before the executor goes away
+		void want(size_t row);  // The view reached row, prefetch if that is near the end of what is loaded
+		
+		int zone_id();  // -1 when closed
+		size_t size();
+		bool complete();  // Every page fetched
+		std::optional<BotRow> row(size_t index);
+
+	private:
+		void run(std::stop_token stop);
+		
+		std::mutex mutex_;
+		std::condition_variable_any wake_;
+		std::jthread worker_;
+		CommandExecutor* executor_ = nullptr;
+		ServerConfig config_;
+		std::unique_ptr<Query> query_;  // Created and used by the worker
+		bool reattached_ = false;       // attach() was called, the worker makes a new query_
+		int zone_id_ = -1;
+		int expected_min_ = 0;
+		int expected_max_ = 0;
+		std::vector<BotRow> rows_;
+		int last_guid_ = 0;        // Highest guid loaded, the next page continues after it
+		bool complete_ = true;
+		bool requested_ = false;   // A page is wanted or being fetched
+		uint64_t generation_ = 0;  // Bumped by open/close/attach so a late page of another zone or server is dropped
+	};
+
+	//* One realm: a name and the settings to reach its server
+	struct RealmConfig {
+		std::string name;
+		ServerConfig server;
+	};
+
+	//* The realm in config first, named "main", then the ones listed in config.realms. Those take
+	//* everything but host, container and database host from config. Malformed entries are skipped.
+	std::vector<RealmConfig> parse_realms(const ServerConfig& config);
+
+	//* Polls every realm but the one in the main view for the overview, on a small shared pool of
+	//* threads. Each realm has its own Query and DB budget and is polled by one worker at a time,
+	//* so a slow realm only ever holds up the worker polling it. Realms on the same host share one
+	//* executor of their own, apart from the main view's.
+	class RealmWatch {
+	public:
+		static constexpr uint64_t POLL_MS = 5000;
+		static constexpr size_t MAX_WORKERS = 8;
+
+		void start(const std::vector<RealmConfig>& realms, size_t primary);
+		void request_stop();  // Cancel the workers without waiting for them, stop() joins them
+		void stop();  // Join the workers
+		std::vector<RealmSummary> summaries();  // Every realm in configured order
+
+	private:
+		struct Host {
+			std::mutex mutex;  // Held while connecting
+			std::shared_ptr<CommandExecutor> executor;
+			uint64_t generation = 0;  // Moves on every reconnect
+		};
+		struct Realm {
+			RealmConfig config;
+			std::shared_ptr<Host> host;
+			std::unique_ptr<Query> query;
+			std::shared_ptr<CommandExecutor> executor;  // What query and its session use, kept alive with them
+			uint64_t generation = 0;  // Host generation query was built for, rebuilt when stale
+			LoadBudget budget;
+			RealmSummary summary;
+			size_t slot = 0;    // Position in order_
+			uint64_t due_ms = 0;
+			bool busy = false;  // A worker is polling it
+		};
+
+		void run(std::stop_token stop);
+		RealmSummary poll(Realm& realm, std::stop_token stop);
+
+		std::mutex mutex_;
+		std::condition_variable_any wake_;
+		std::vector<std::unique_ptr<Realm>> realms_;
+		std::vector<RealmSummary> order_;  // Configured order, the primary realm included
+		uint64_t finished_ = 0;            // Polls finished, wakes workers waiting on a busy realm
+		std::vector<std::jthread> workers_;
+	};
+
 	//* Global state
 	extern std::atomic<bool> enabled;
 	extern std::atomic<bool> active;
 	extern ServerConfig config;
 	extern std::unique_ptr<SSHClient> ssh_client;
 	extern std::unique_ptr<Query> query;
-	extern ServerData current_data;
-	extern ExpectedValues expected_values;
+	extern ExpectedValues expected_values;  // Collector thread only, the UI reads snapshot()->expected
+	extern LoadBudget load_budget;
+	extern QueryCache query_cache;
+	extern BotList bot_list;
+	extern RealmWatch realm_watch;
+	
+	//* Name index over the online bots for the search prompt. The collector swaps in a new one
+	//* every cycle, readers keep the snapshot they got for as long as they use it.
+	std::shared_ptr<const Names::Index> name_index();
+	
+	//* Latest data the collector thread published, never null. Snapshots are immutable, a reader
+	//* keeps the one it got for as long as it uses it while the collector builds the next.
+	std::shared_ptr<const ServerData> snapshot();
+	
+	//* Have the collector EXPLAIN the collection queries after its next cycle. Returns the request,
+	//* the report comes with the first snapshot whose advice_request is at least that.
+	uint64_t request_advice();
+	
+	//* True once per published snapshot, so the UI can draw it without waiting for its next tick
+	bool take_published();
 	
-	//* Historical data for graphs (server load percentage over time)
-	extern std::deque<long long> load_history;
+	//* Eventfd that turns readable when a snapshot is published, for the main event loop to watch.
+	//* take_published() drains it.
+	int published_fd();
+	
+	//* Eco mode: while nobody is looking, collection drops to a slow cadence of status and bot count only.
+	//* The main thread feeds it terminal focus reports and input, and asks tmux or screen whether the
+	//* window is shown. eco_interval() is read by the collector and the realm watchers.
+	void eco_focus(bool focused);
+	void eco_activity();
+	bool eco_update();        // Re-evaluate, true when eco mode was entered or left
+	uint64_t eco_interval();  // Collection interval in ms while in eco mode, 0 at full rate
 	
 	//* Check if server is online (returns true if container is running)
 	bool check_server_online();
@@ -594,15 +1258,49 @@ namespace AzerothCore {
 	//* Load expected values from server config file
 	void load_expected_values();
 	
+	//* Level distribution of all bots, each faction binned by its own configured brackets
+	std::vector<LevelBracket> level_brackets(const LevelHistogram& histogram);
+
+	//* A two-way breakdown rolled up from the cube
+	struct Pivot {
+		struct Row {
+			std::string label;
+			std::vector<int> cells;  // One per column
+			int total = 0;
+		};
+		std::string title;
+		std::vector<std::string> columns;
+		std::vector<Row> rows;
+	};
+
+	enum class PivotView { CLASS_BY_ZONE, RACE_BY_BRACKET, FACTION_BY_CONTINENT };
+	constexpr int PIVOT_VIEWS = 3;
+
+	//* Counts are multiplied by scale, the sample scale when the cube was sampled. Brackets are taken
+	//* from expected, the ones of the snapshot the cube came with.
+	Pivot pivot(const BotCube& cube, PivotView view, const ExpectedValues& expected, double scale = 1.0);
+
+	//* Re-derive the level brackets after the bracket layout changed, no query involved
+	void rebin_current();
+
 	//* Reset all stats and clear display data (called on disconnect/restart detection)
 	void reset_stats();
 
 	//* Initialize AzerothCore monitoring
 	void init();
 
-	//* Update data (call from collector thread)
+	//* Ask the collector thread for a cycle and return at once. Requests made while a cycle
+	//* is running are folded into one follow-up cycle.
 	void collect();
 
+	//* Show realm index of realm_watch.summaries() in the main view. The collector reconnects
+	//* before its next cycle, the realm shown so far joins the overview.
+	void switch_realm(size_t index);
+	
+	//* Hand over settings from a reloaded config. The collector takes them before its next cycle, it
+	//* reconnects when reconnect_needed, otherwise it only swaps in the budget, table and eco values.
+	void reconfigure(const ServerConfig& next, bool reconnect_needed);
+
 	//* Cleanup
 	void cleanup();
 
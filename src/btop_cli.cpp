@@ -64,10 +64,18 @@ namespace Cli {
 				return std::unexpected { 0 };
 			}
 
+			if (arg == "--advise") {
+				cli.advise = true;
+				continue;
+			}
 			if (arg == "-d" || arg == "--debug") {
 				cli.debug = true;
 				continue;
 			}
+			if (arg == "--install-summary") {
+				cli.install_summary = true;
+				continue;
+			}
 			if (arg == "--force-utf") {
 				cli.force_utf = true;
 				continue;
@@ -194,10 +202,12 @@ namespace Cli {
 	void help() noexcept {
 		fmt::print(
 			"{0}Options:{1}\n"
+			"  {2}    --advise{1}            EXPLAIN the monitoring queries, suggest indexes and exit\n"
 			"  {2}-c, --config{1} <file>     Path to a config file\n"
 			"  {2}-d, --debug{1}             Start in debug mode with additional logs and metrics\n"
 			"  {2}-f, --filter{1} <filter>   Set an initial process filter\n"
 			"  {2}    --force-utf{1}         Override automatic UTF locale detection\n"
+			"  {2}    --install-summary{1}   Install the online bot summary table and event, then exit\n"
 			"  {2}-l, --low-color{1}         Disable true color, 256 colors only\n"
 			"  {2}-p, --preset{1} <id>       Start with a preset (0-9)\n"
 			"  {2}-t, --tty{1}               Force tty mode with ANSI graph symbols and 16 colors only\n"
@@ -14,10 +14,14 @@ namespace Cli {
 
 	// Configuration options set via the command line.
 	struct Cli {
+		// Print an index report for the monitoring queries and exit
+		bool advise {};
 		// Alternate path to a configuration file
 		std::optional<stdfs::path> config_file;
 		// Enable debug mode with additional logs and metrics
 		bool debug {};
+		// Install the server-maintained summary table after confirmation and exit
+		bool install_summary {};
 		// Set an initial process filter.
 		std::optional<std::string> filter;
 		// Only use ANSI supported graph symbols and colors
@@ -149,6 +149,24 @@ namespace Config {
 		{"azerothcore_ra_password",	"#* RA (Remote Administrator) password for WorldServer console access.\n"
 									"#* SECURITY: Recommended to set via environment variable: BOTTOP_AC_RA_PASSWORD"},
 		{"azerothcore_config_path",	"#* Path to worldserver.conf on remote server for expected values (optional)."},
+		{"azerothcore_worldserver_db_user",	"#* MySQL user the worldserver connects as, the locks view only lists its transactions.\n"
+									"#* Empty to list every connection but bottop's own."},
+		{"azerothcore_realms",		"#* Other realms for the realms view, space separated \"name|host|container[|db_host]\" entries.\n"
+									"#* host is an SSH host or \"local\", everything else is shared with the realm configured above.\n"
+									"#* Example: \"ptr|admin@ptr.example.com|ac-worldserver classic|local|ac-classic-worldserver\""},
+		{"azerothcore_rtt_budget_ms",	"#* Milliseconds per minute bottop's own queries may spend in round trips, 0 to disable.\n"
+									"#* A round trip covers SSH, docker exec and MySQL, an upper bound on the load put on the server.\n"
+									"#* When exceeded, low priority sources are dropped and full refreshes are spaced out."},
+		{"azerothcore_sample_margin",	"#* Estimate distributions from a sample of online bots instead of counting all of them.\n"
+									"#* Target margin of error at 95% confidence in tenths of a percent (5 = +-0.5%), 0 for exact counts.\n"
+									"#* Exact counts are still taken every 5 minutes to reconcile."},
+		{"azerothcore_table_limit_mb",	"#* Size in MiB a character database table is projected to grow to in the tables view, 0 to disable.\n"
+									"#* Table sizes are read every 10 minutes, growth rates cover the last 6 hours."},
+		{"azerothcore_eco_idle_s",	"#* Seconds without a key press before eco mode, 0 to disable eco mode. Off by default, a dashboard\n"
+									"#* nobody types into would otherwise drop to eco mode.\n"
+									"#* Eco mode also starts when the terminal reports losing focus or tmux/screen hide or detach the window,\n"
+									"#* and ends on focus or any key. It reads only the status and bot count, graphs mark the cycles it collected."},
+		{"azerothcore_eco_ms",		"#* Milliseconds between collections in eco mode, 1000-3600000."},
 	#endif
 	};
 
@@ -221,7 +239,9 @@ namespace Config {
 		{"azerothcore_container", ""},
 		{"azerothcore_ra_username", ""},
 		{"azerothcore_ra_password", ""},
-		{"azerothcore_config_path", ""}
+		{"azerothcore_config_path", ""},
+		{"azerothcore_worldserver_db_user", "acore"},
+		{"azerothcore_realms", ""}
 	#endif
 	};
 	std::unordered_map<std::string_view, string> stringsTmp;
@@ -297,10 +317,44 @@ namespace Config {
 		{"selected_depth", 0},
 		{"proc_start", 0},
 		{"proc_selected", 0},
-		{"proc_last_selected", 0}
+		{"proc_last_selected", 0},
+	#ifdef AZEROTHCORE_SUPPORT
+		{"azerothcore_rtt_budget_ms", 0},
+		{"azerothcore_sample_margin", 0},
+		{"azerothcore_table_limit_mb", 10240},
+		{"azerothcore_eco_idle_s", 0},
+		{"azerothcore_eco_ms", 60000},
+	#endif
 	};
 	std::unordered_map<std::string_view, int> intsTmp;
 
+	//* Config keys of BoolKey, IntKey and StringKey, in enum order
+	constexpr array bool_keys {
+		"terminal_sync"sv, "tty_mode"sv, "background_update"sv, "rounded_corners"sv, "cpu_bottom"sv, "show_battery"sv, "base_10_sizes"sv,
+	#ifdef AZEROTHCORE_SUPPORT
+		"azerothcore_enabled"sv,
+	#endif
+	};
+	constexpr array int_keys { "update_ms"sv };
+	constexpr array string_keys { "clock_format"sv, "graph_symbol"sv, "base_10_bitrate"sv };
+	static_assert(bool_keys.size() == static_cast<size_t>(BoolKey::count));
+	static_assert(int_keys.size() == static_cast<size_t>(IntKey::count));
+	static_assert(string_keys.size() == static_cast<size_t>(StringKey::count));
+
+	//* Point each slot at its entry, entries are never erased so the pointers stay valid
+	template <typename T, size_t N>
+	array<T*, N> bind_slots(std::unordered_map<std::string_view, T>& values, const array<string_view, N>& keys) {
+		array<T*, N> slots;
+		for (size_t i = 0; i < N; i++) slots[i] = &values.at(keys[i]);
+		return slots;
+	}
+
+	array<bool*, static_cast<size_t>(BoolKey::count)> bool_slots = bind_slots(bools, bool_keys);
+	array<int*, static_cast<size_t>(IntKey::count)> int_slots = bind_slots(ints, int_keys);
+	array<string*, static_cast<size_t>(StringKey::count)> string_slots = bind_slots(strings, string_keys);
+
+	atomic<uint64_t> generation (0);
+
 	// Returns a valid config dir or an empty optional
 	// The config dir might be read only, a warning is printed, but a path is returned anyway
 	[[nodiscard]] std::optional<fs::path> get_config_dir() noexcept {
@@ -483,6 +537,21 @@ namespace Config {
 		else if (name == "update_ms" and i_value > ONE_DAY_MILLIS)
 			validError = fmt::format("Config value update_ms set too high (>{}).", ONE_DAY_MILLIS);
 
+		else if (name == "azerothcore_rtt_budget_ms" and (i_value < 0 or i_value > 60000))
+			validError = "Config value azerothcore_rtt_budget_ms must be between 0 and 60000.";
+
+		else if (name == "azerothcore_sample_margin" and (i_value < 0 or i_value > 100))
+			validError = "Config value azerothcore_sample_margin must be between 0 and 100.";
+
+		else if (name == "azerothcore_table_limit_mb" and (i_value < 0 or i_value > 100000000))
+			validError = "Config value azerothcore_table_limit_mb must be between 0 and 100000000.";
+
+		else if (name == "azerothcore_eco_idle_s" and (i_value < 0 or i_value > 86400))
+			validError = "Config value azerothcore_eco_idle_s must be between 0 and 86400.";
+
+		else if (name == "azerothcore_eco_ms" and (i_value < 1000 or i_value > 3600000))
+			validError = "Config value azerothcore_eco_ms must be between 1000 and 3600000.";
+
 		else
 			return true;
 
@@ -579,7 +648,10 @@ namespace Config {
 			if (boolsTmp.contains(name)) boolsTmp.at(name) = not boolsTmp.at(name);
 			else boolsTmp.insert_or_assign(name, (not bools.at(name)));
 		}
-		else bools.at(name) = not bools.at(name);
+		else {
+			bools.at(name) = not bools.at(name);
+			++generation;
+		}
 	}
 
 	void unlock() {
@@ -587,6 +659,7 @@ namespace Config {
 		atomic_wait(Runner::active);
 		atomic_lock lck(writelock, true);
 		try {
+			const bool any_set = Proc::shown or not (stringsTmp.empty() and intsTmp.empty() and boolsTmp.empty());
 			if (Proc::shown) {
 				ints.at("selected_pid") = Proc::selected_pid;
 				strings.at("selected_name") = Proc::selected_name;
@@ -609,6 +682,7 @@ namespace Config {
 				bools.at(item.first) = item.second;
 			}
 			boolsTmp.clear();
+			if (any_set) ++generation;
 		}
 		catch (const std::exception& e) {
 			Global::exit_error_msg = "Exception during Config::unlock() : " + string{e.what()};
@@ -691,7 +765,7 @@ namespace Config {
 		}
 	}
 
-	void load_env_overrides() {
+	void load_env_overrides([[maybe_unused]] std::unordered_map<std::string_view, string>& strings) {
 		// Load sensitive settings from environment variables
 		// This allows keeping passwords out of config files
 		#ifdef AZEROTHCORE_SUPPORT
@@ -722,23 +796,20 @@ namespace Config {
 		#endif
 	}
 
-	void load(const fs::path& conf_file, vector<string>& load_warnings) {
-		std::error_code error;
-		if (conf_file.empty())
-			return;
-		else if (not fs::exists(conf_file, error)) {
-			write_new = true;
-			// Load environment variables even if config file doesn't exist
-			load_env_overrides();
-		
-		// Auto-adjust update_ms based on SSH vs local connection
-		adjust_update_ms_for_connection();
-			return;
-		}
-		if (error) {
-			return;
-		}
+	//* Values the config file held when it was last read, reload() applies only what differs from them
+	std::unordered_map<std::string_view, bool> file_bools;
+	std::unordered_map<std::string_view, int> file_ints;
+	std::unordered_map<std::string_view, string> file_strings;
+	fs::file_time_type file_time;
+
+	//* Keys read under their old name, the file is written again with the new one
+	const std::unordered_map<string, string> renamed_keys = {
+		{"azerothcore_db_budget_ms", "azerothcore_rtt_budget_ms"},
+	};
 
+	//* Read the config file into the given maps, keys missing from the file keep the value they had
+	void read_file(const fs::path& conf_file, vector<string>& load_warnings, std::unordered_map<std::string_view, bool>& bools,
+			std::unordered_map<std::string_view, int>& ints, std::unordered_map<std::string_view, string>& strings) {
 		std::ifstream cread(conf_file);
 		if (cread.good()) {
 			vector<string> valid_names;
@@ -756,6 +827,10 @@ namespace Config {
 				string name, value;
 				getline(cread, name, '=');
 				if (name.ends_with(' ')) name = trim(name);
+				if (auto renamed = renamed_keys.find(name); renamed != renamed_keys.end()) {
+					name = renamed->second;
+					write_new = true;
+				}
 				if (not v_contains(valid_names, name)) {
 					cread.ignore(SSmax, '\n');
 					continue;
@@ -800,7 +875,75 @@ namespace Config {
 		
 		// Load environment variable overrides after reading config file
 		// This allows environment variables to override config file values
-		load_env_overrides();
+		load_env_overrides(strings);
+	}
+
+	void load(const fs::path& conf_file, vector<string>& load_warnings) {
+		std::error_code error;
+		if (conf_file.empty())
+			return;
+		else if (not fs::exists(conf_file, error)) {
+			write_new = true;
+			// Load environment variables even if config file doesn't exist
+			load_env_overrides(strings);
+		
+		// Auto-adjust update_ms based on SSH vs local connection
+		adjust_update_ms_for_connection();
+			++generation;
+			return;
+		}
+		if (error) {
+			return;
+		}
+
+		file_time = fs::last_write_time(conf_file, error);
+		read_file(conf_file, load_warnings, bools, ints, strings);
+		++generation;
+		file_bools = bools;
+		file_ints = ints;
+		file_strings = strings;
+	}
+
+	bool modified(const fs::path& conf_file) {
+		std::error_code error;
+		const auto time = fs::last_write_time(conf_file, error);
+		return not error and time != file_time;
+	}
+
+	vector<string_view> reload(const fs::path& conf_file, vector<string>& load_warnings) {
+		vector<string_view> changed;
+		std::error_code error;
+		if (conf_file.empty() or not fs::exists(conf_file, error)) return changed;
+		file_time = fs::last_write_time(conf_file, error);
+
+		//? Started without a file, what is in use now is the baseline
+		if (file_bools.empty()) {
+			file_bools = bools;
+			file_ints = ints;
+			file_strings = strings;
+		}
+		auto next_bools = file_bools;
+		auto next_ints = file_ints;
+		auto next_strings = file_strings;
+		read_file(conf_file, load_warnings, next_bools, next_ints, next_strings);
+
+		//? The values come from the file, setting them is no reason to write it back
+		const bool keep_write_new = write_new;
+		for (const auto& [name, value] : next_bools) {
+			if (value != file_bools.at(name)) { set(name, value); changed.push_back(name); }
+		}
+		for (const auto& [name, value] : next_ints) {
+			if (value != file_ints.at(name)) { set(name, value); changed.push_back(name); }
+		}
+		for (const auto& [name, value] : next_strings) {
+			if (value != file_strings.at(name)) { set(name, value); changed.push_back(name); }
+		}
+		write_new = keep_write_new or not load_warnings.empty();
+
+		file_bools = std::move(next_bools);
+		file_ints = std::move(next_ints);
+		file_strings = std::move(next_strings);
+		return changed;
 	}
 
 	void write() {
@@ -18,9 +18,15 @@ tab-size = 4
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <unordered_map>
@@ -96,6 +102,69 @@ namespace Config {
 
 	string getAsString(const std::string_view name);
 
+	//* Settings read on hot paths, named like their config keys. Each id is bound to its entry in bools,
+	//* ints or strings at startup, so reading one indexes a flat array instead of hashing the name.
+	enum class BoolKey : size_t {
+		terminal_sync, tty_mode, background_update, rounded_corners, cpu_bottom, show_battery, base_10_sizes,
+	#ifdef AZEROTHCORE_SUPPORT
+		azerothcore_enabled,
+	#endif
+		count
+	};
+	enum class IntKey : size_t { update_ms, count };
+	enum class StringKey : size_t { clock_format, graph_symbol, base_10_bitrate, count };
+
+	extern std::array<bool*, static_cast<size_t>(BoolKey::count)> bool_slots;
+	extern std::array<int*, static_cast<size_t>(IntKey::count)> int_slots;
+	extern std::array<string*, static_cast<size_t>(StringKey::count)> string_slots;
+
+	//* Moves on every change of a config value
+	extern std::atomic<uint64_t> generation;
+
+	//* Return bool for config key <key>
+	inline bool getB(const BoolKey key) { return *bool_slots[static_cast<size_t>(key)]; }
+
+	//* Return integer for config key <key>
+	inline const int& getI(const IntKey key) { return *int_slots[static_cast<size_t>(key)]; }
+
+	//* Return string for config key <key>
+	inline const string& getS(const StringKey key) { return *string_slots[static_cast<size_t>(key)]; }
+
+	//* Copy of a hot setting that tells when it changed. Values are only compared once the generation
+	//* moved, so checking it on every pass of a loop costs one atomic load.
+	template <typename Key>
+	class Watch {
+		using Value = std::conditional_t<std::is_same_v<Key, BoolKey>, bool,
+			std::conditional_t<std::is_same_v<Key, IntKey>, int, string>>;
+
+		static Value read(const Key key) {
+			if constexpr (std::is_same_v<Key, BoolKey>) return getB(key);
+			else if constexpr (std::is_same_v<Key, IntKey>) return getI(key);
+			else return getS(key);
+		}
+
+		Key key;
+		uint64_t seen;
+		Value current;
+	public:
+		explicit Watch(const Key key) : key(key), seen(generation.load()), current(read(key)) {}
+
+		//* The value as of the last changed()
+		const Value& value() const { return current; }
+
+		//* Whether the setting has another value than on the last call
+		bool changed() {
+			if (const uint64_t now = generation.load(); now != seen) {
+				seen = now;
+				if (Value next = read(key); next != current) {
+					current = std::move(next);
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
 	extern string validError;
 
 	bool intValid(const std::string_view name, const string& value);
@@ -104,19 +173,28 @@ namespace Config {
 	//* Set config key <name> to bool <value>
 	inline void set(const std::string_view name, bool value) {
 		if (_locked(name)) boolsTmp.insert_or_assign(name, value);
-		else bools.at(name) = value;
+		else {
+			bools.at(name) = value;
+			++generation;
+		}
 	}
 
 	//* Set config key <name> to int <value>
 	inline void set(const std::string_view name, const int value) {
 		if (_locked(name)) intsTmp.insert_or_assign(name, value);
-		else ints.at(name) = value;
+		else {
+			ints.at(name) = value;
+			++generation;
+		}
 	}
 
 	//* Set config key <name> to string <value>
 	inline void set(const std::string_view name, const string& value) {
 		if (_locked(name)) stringsTmp.insert_or_assign(name, value);
-		else strings.at(name) = value;
+		else {
+			strings.at(name) = value;
+			++generation;
+		}
 	}
 
 	//* Flip config key bool <name>
@@ -131,6 +209,12 @@ namespace Config {
 	//* Load the config file from disk
 	void load(const std::filesystem::path& conf_file, vector<string>& load_warnings);
 
+	//* Check if the config file was written since it was last read
+	bool modified(const std::filesystem::path& conf_file);
+
+	//* Read the config file again and set only the keys whose value changed in it, returns their names
+	vector<std::string_view> reload(const std::filesystem::path& conf_file, vector<string>& load_warnings);
+
 	//* Write the config file to disk
 	void write();
 
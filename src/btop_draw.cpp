@@ -262,8 +262,8 @@ namespace Draw {
 		if (line_color.empty())
 			line_color = Theme::c("div_line");
 
-		auto tty_mode = Config::getB("tty_mode");
-		auto rounded = Config::getB("rounded_corners");
+		auto tty_mode = Config::getB(Config::BoolKey::tty_mode);
+		auto rounded = Config::getB(Config::BoolKey::rounded_corners);
 		const string numbering = (num == 0) ? "" : Theme::c("hi_fg") + (tty_mode ? std::to_string(num) : Symbols::superscript.at(clamp(num, 0, 9)));
 		const auto& right_up = (tty_mode or not rounded ? Symbols::right_up : Symbols::round_right_up);
 		const auto& left_up = (tty_mode or not rounded ? Symbols::left_up : Symbols::round_left_up);
@@ -308,7 +308,7 @@ namespace Draw {
 	}
 
 	bool update_clock(bool force) {
-		const auto& clock_format = Config::getS("clock_format");
+		const auto& clock_format = Config::getS(Config::StringKey::clock_format);
 		if (not Cpu::shown or clock_format.empty()) {
 			if (clock_format.empty() and not Global::clock.empty()) Global::clock.clear();
 			return false;
@@ -334,7 +334,7 @@ namespace Draw {
 		}
 
 		auto& out = Global::clock;
-		auto cpu_bottom = Config::getB("cpu_bottom");
+		auto cpu_bottom = Config::getB(Config::BoolKey::cpu_bottom);
 		const auto& x = Cpu::x;
 		const auto y = (cpu_bottom ? Cpu::y + Cpu::height - 1 : Cpu::y);
 		const auto& width = Cpu::width;
@@ -356,7 +356,7 @@ namespace Draw {
 
 		}
 
-		clock_str = uresize(clock_str, std::max(10, width - 66 - (Term::width >= 100 and Config::getB("show_battery") and Cpu::has_battery ? 22 : 0)));
+		clock_str = uresize(clock_str, std::max(10, width - 66 - (Term::width >= 100 and Config::getB(Config::BoolKey::show_battery) and Cpu::has_battery ? 22 : 0)));
 		out.clear();
 
 		if (clock_str.size() != clock_len) {
@@ -472,9 +472,9 @@ namespace Draw {
 				 bool invert, bool no_zero, long long max_value, long long offset)
 	: width(width), height(height), color_gradient(color_gradient),
 	  invert(invert), no_zero(no_zero), offset(offset) {
-		if (Config::getB("tty_mode") or symbol == "tty") this->symbol = "tty";
+		if (Config::getB(Config::BoolKey::tty_mode) or symbol == "tty") this->symbol = "tty";
 		else if (symbol != "default") this->symbol = symbol;
-		else this->symbol = Config::getS("graph_symbol");
+		else this->symbol = Config::getS(Config::StringKey::graph_symbol);
 		if (this->symbol == "tty") tty_mode = true;
 
 		if (max_value == 0 and offset > 0) max_value = 100;
@@ -1474,7 +1474,8 @@ namespace Draw {
 			
 			// Calculate distribution pane height dynamically based on detected brackets
 			// Formula: 3 (factions) + 5 (continents) + (N+1) (levels) + 2 (borders) + 1 (spacing)
-			int num_level_brackets = ::AzerothCore::expected_values.bracket_definitions.size();
+			layout_brackets = ::AzerothCore::snapshot()->expected.bracket_definitions.size();
+			int num_level_brackets = layout_brackets;
 			if (num_level_brackets == 0) num_level_brackets = 8;  // Default to 8 if not loaded yet
 			
 			// Height calculation (exact content fit):
@@ -1499,7 +1500,7 @@ namespace Draw {
 			// Create boxes
 			perf_box = createBox(perf_x, perf_y, perf_width, perf_height, Theme::c("cpu_box"), true, "server performance", "", 9);
 			dist_box = createBox(dist_x, dist_y, dist_width, dist_height, Theme::c("mem_box"), true, "bot distribution", "", 8);
-			zones_box = createBox(x, zones_y, width, zones_height, Theme::c("proc_box"), true, "zones", "", 10);
+			zones_box = createBox(x, zones_y, width, zones_height, Theme::c("proc_box"), true, AzerothCore::bottom_title(), "", 10);
 			box = perf_box + dist_box + zones_box;
 			
 			zone_select_max = zones_height - 4;  // Account for header and borders
@@ -1538,6 +1539,11 @@ namespace Draw {
 	int selected_zone = 0;
 	bool zone_selection_active = false;
 	bool zone_filtering = false;
+	Draw::TextEdit name_search;
+	bool name_searching = false;
+	int name_selected = 0;
+	int realm_selected = 0;
+	int pending_zone_jump = -1;
 	std::set<size_t> expanded_zones;
 	std::set<std::string> expanded_continents;  // Track which continents are expanded
 	
@@ -1561,6 +1567,310 @@ namespace Draw {
 		
 		std::unordered_map<string, Draw::Graph> graphs;
 		std::unordered_map<string, Draw::Meter> meters;
+		
+		//* Bottom pane view
+		BottomView bottom_view = BottomView::ZONES;
+		
+		size_t layout_brackets = 0;
+		
+		bool layout_stale() {
+			return shown and ::AzerothCore::snapshot()->expected.bracket_definitions.size() != layout_brackets;
+		}
+		
+		string bottom_title() {
+			switch (bottom_view) {
+				case BottomView::TABLES: return "tables";
+				case BottomView::LOCKS: return "locks";
+				case BottomView::HEALTH: return "mysql";
+				case BottomView::REALMS: return "realms";
+				default: return "zones";
+			}
+		}
+		
+		//* "3h", "12d", "-" when not growing, "over" when past the limit
+		static string format_eta(double hours) {
+			if (hours < 0) return "-";
+			if (hours == 0) return "over";
+			if (hours < 1) return to_string((int)std::ceil(hours * 60)) + "m";
+			if (hours < 48) return to_string((int)hours) + "h";
+			if (hours < 24 * 365) return to_string((int)(hours / 24)) + "d";
+			return to_string((int)(hours / (24 * 365))) + "y";
+		}
+		
+		//* Character database tables, fastest growing first
+		static string tables_view(const ::AzerothCore::TableReport& report) {
+			string out;
+			int cy = zones_y + 1;
+			const string main_fg = Theme::c("main_fg");
+			const string title = Theme::c("title");
+			
+			out += Mv::to(cy, x + 2) + title + "Table";
+			out += Mv::to(cy, x + 32) + rjust("Size", 10);
+			out += Mv::to(cy, x + 43) + rjust("Rows", 11);
+			out += Mv::to(cy, x + 55) + rjust("Growth/h", 11);
+			out += Mv::to(cy, x + 67) + rjust("To limit", 9);
+			cy++;
+			out += Mv::to(cy++, x + 2) + Theme::c("div_line") + Symbols::h_line * (width - 4);
+			
+			if (report.tables.empty()) {
+				out += Mv::to(cy, x + 4) + Theme::c("inactive_fg") + "Table sizes are read every 10 minutes, waiting for the first sample";
+			}
+			const bool rates = report.samples >= 2;
+			for (const auto& table : report.tables) {
+				if (cy >= zones_y + zones_height - 1) break;
+				string growth = "-";
+				if (rates and table.bytes_per_hour >= 1.0) growth = "+" + floating_humanizer((uint64_t)table.bytes_per_hour);
+				string eta_color = main_fg;
+				if (table.hours_to_limit >= 0 and table.hours_to_limit < 24) eta_color = title;
+				else if (table.hours_to_limit >= 0 and table.hours_to_limit < 24 * 7) eta_color = "\x1b[93m";
+				
+				out += Mv::to(cy, x + 2) + main_fg + ljust(table.name, 29, true);
+				out += Mv::to(cy, x + 32) + rjust(floating_humanizer(table.bytes()), 10);
+				out += Mv::to(cy, x + 43) + rjust(to_string(table.rows), 11);
+				out += Mv::to(cy, x + 55) + (growth == "-" ? Theme::c("inactive_fg") : Theme::c("hi_fg")) + rjust(growth, 11);
+				out += Mv::to(cy, x + 67) + eta_color + rjust(rates ? format_eta(table.hours_to_limit) : "-", 9);
+				cy++;
+			}
+			
+			string status;
+			if (report.tables.empty()) status = "";
+			else if (not rates) status = "Growth rates need a second sample, read every 10 minutes";
+			else status = to_string(report.samples) + " samples over " + format_eta(report.window_ms / 3600000.0);
+			if (report.limit_bytes > 0 and not status.empty()) status += ", limit " + floating_humanizer(report.limit_bytes);
+			out += Mv::to(zones_y + zones_height - 1, x + 1) + string(width - 2, ' ');
+			out += Mv::to(zones_y + zones_height - 1, x + 2) + Theme::c("hi_fg") + "Tab:View  " + Theme::c("graph_text") + status;
+			return out;
+		}
+
+		//* Last columns samples of history as block characters, scaled from floor to the largest visible sample.
+		//* Series of equal length end on the same cycle, so sparklines drawn at equal width line up.
+		template<typename Series>
+		static string sparkline(const Series& history, int columns, double floor = 0.0) {
+			static const array<string, 8> blocks = {"▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+			const size_t slots = (size_t)std::max(columns, 0);
+			const size_t count = std::min(history.size(), slots);
+			const size_t first = history.size() - count;
+			double peak = floor;
+			for (size_t i = first; i < history.size(); i++) peak = std::max(peak, (double)history[i]);
+			string out(slots - count, ' ');
+			for (size_t i = first; i < history.size(); i++) {
+				const double value = history[i];
+				if (value < 0) out += ' ';  // No sample that cycle
+				else out += blocks[peak > floor ? std::clamp((int)((value - floor) * 8 / (peak - floor)), 0, 7) : 0];
+			}
+			return out;
+		}
+		
+		//* Lock waits and statement time next to the update time, then the transactions and digests behind them
+		static string locks_view(const ::AzerothCore::ServerData& data) {
+			const auto& report = data.locks;
+			string out;
+			int cy = zones_y + 1;
+			const int bottom = zones_y + zones_height - 1;
+			const string main_fg = Theme::c("main_fg");
+			const string title = Theme::c("title");
+			const string inactive = Theme::c("inactive_fg");
+			const int spark_width = std::max(10, width - 32);
+			
+			auto series = [&](const string& label, const std::deque<long long>& history, const string& value) {
+				out += Mv::to(cy, x + 2) + main_fg + ljust(label, 14);
+				out += Theme::c("graph_text") + sparkline(history, spark_width);
+				out += Mv::to(cy, x + 17 + spark_width) + main_fg + rjust(value, 12);
+				cy++;
+			};
+			const auto& load = data.load_history;
+			series("Update time", load, load.empty() ? "-" : to_string(load.back()) + "ms");
+			series("Lock waits", data.lock_wait_history, report.available ? to_string(report.lock_waits) : "-");
+			series("Statement ms", data.statement_ms_history, report.available ? to_string(report.statement_ms) : "-");
+			out += Mv::to(cy++, x + 2) + Theme::c("div_line") + Symbols::h_line * (width - 4);
+			
+			if (not report.available) {
+				out += Mv::to(cy, x + 4) + inactive + "information_schema and performance_schema were not readable this cycle";
+			}
+			else {
+				out += Mv::to(cy, x + 2) + title + "Thread";
+				out += Mv::to(cy, x + 11) + rjust("Age", 7);
+				out += Mv::to(cy, x + 19) + rjust("Locked", 8);
+				out += Mv::to(cy, x + 29) + "State";
+				out += Mv::to(cy, x + 41) + "Query";
+				cy++;
+				if (report.transactions.empty() and cy < bottom) {
+					out += Mv::to(cy++, x + 4) + inactive + "No open transactions";
+				}
+				for (const auto& trx : report.transactions) {
+					if (cy >= bottom - 2) break;
+					const bool waiting = trx.state == "LOCK WAIT";
+					out += Mv::to(cy, x + 2) + main_fg + ljust(to_string(trx.thread_id), 8);
+					out += Mv::to(cy, x + 11) + rjust(to_string(trx.age_s) + "s", 7);
+					out += Mv::to(cy, x + 19) + rjust(to_string(trx.rows_locked), 8);
+					out += Mv::to(cy, x + 29) + (waiting ? title : main_fg) + ljust(trx.state, 11, true);
+					out += Mv::to(cy, x + 41) + main_fg + ljust(trx.query, std::max(0, width - 43), true);
+					cy++;
+				}
+				
+				if (cy < bottom - 1) {
+					cy++;
+					out += Mv::to(cy, x + 2) + title + rjust("Time", 8);
+					out += Mv::to(cy, x + 11) + rjust("Calls", 7);
+					out += Mv::to(cy, x + 19) + "Statement";
+					cy++;
+				}
+				if (report.digests.empty() and cy < bottom) {
+					out += Mv::to(cy++, x + 4) + inactive + "No statements in the characters database since the last read";
+				}
+				for (const auto& digest : report.digests) {
+					if (cy >= bottom) break;
+					out += Mv::to(cy, x + 2) + main_fg + rjust(to_string(digest.ms) + "ms", 8);
+					out += Mv::to(cy, x + 11) + rjust(to_string(digest.calls), 7);
+					out += Mv::to(cy, x + 19) + ljust(digest.text, std::max(0, width - 21), true);
+					cy++;
+				}
+			}
+			
+			string status;
+			if (report.available) {
+				status = to_string(report.lock_waits) + " waiting";
+				if (report.lock_waits > 0) status += ", longest " + to_string(report.longest_wait_s) + "s";
+				if (report.interval_s > 0) status += ", statements per " + to_string((int)std::round(report.interval_s)) + "s";
+			}
+			out += Mv::to(bottom, x + 1) + string(width - 2, ' ');
+			out += Mv::to(bottom, x + 2) + Theme::c("hi_fg") + "Tab:View  " + Theme::c("graph_text") + status;
+			return out;
+		}
+
+		//* "12", "3.4k", "1.2M" for rates
+		static string format_rate(double value) {
+			if (value < 10) return fmt::format("{:.1f}", value);
+			if (value < 1000) return to_string((int)std::round(value));
+			if (value < 1000000) return fmt::format("{:.1f}k", value / 1000);
+			return fmt::format("{:.1f}M", value / 1000000);
+		}
+		
+		//* MySQL server rates and threads, each series on the update-time timeline
+		static string health_view(const ::AzerothCore::DbHealth& health) {
+			string out;
+			int cy = zones_y + 1;
+			const int bottom = zones_y + zones_height - 1;
+			const string main_fg = Theme::c("main_fg");
+			const string title = Theme::c("title");
+			const string inactive = Theme::c("inactive_fg");
+			const int spark_width = std::max(10, width - 34);
+			
+			if (health.qps_history.size() == 0) {
+				out += Mv::to(cy, x + 4) + inactive + "Waiting for the first SHOW GLOBAL STATUS sample";
+			}
+			auto series = [&](const string& label, const ::AzerothCore::HealthSeries& history, const string& value,
+							  bool alert = false, double floor = 0.0) {
+				if (cy >= bottom) return;
+				out += Mv::to(cy, x + 2) + main_fg + ljust(label, 16);
+				out += Theme::c("graph_text") + sparkline(history, spark_width, floor);
+				out += Mv::to(cy, x + 19 + spark_width) + (alert ? title : main_fg) + rjust(value, 12);
+				cy++;
+			};
+			const bool rates = health.rates;
+			const bool threads = health.available;
+			const bool saturated = health.max_connections > 0 and health.threads_connected * 10 >= health.max_connections * 9;
+			if (health.qps_history.size() > 0) {
+				series("Queries/s", health.qps_history, rates ? format_rate(health.qps) : "-");
+				series("Slow queries/s", health.slow_history, rates ? format_rate(health.slow_per_s) : "-", rates and health.slow_per_s > 0);
+				//? The hit ratio lives in the high nineties, scaled from 90% so dips stand out
+				series("Buffer pool hit", health.hit_history, rates ? fmt::format("{:.2f}%", health.hit_pct) : "-", rates and health.hit_pct < 99.0, 90.0);
+				series("Rows read/s", health.reads_history, rates ? format_rate(health.reads_per_s) : "-");
+				series("Rows written/s", health.writes_history, rates ? format_rate(health.writes_per_s) : "-");
+				series("Threads running", health.running_history, threads ? to_string(health.threads_running) : "-");
+				series("Connections", health.connected_history,
+					threads ? to_string(health.threads_connected) + "/" + to_string(health.max_connections) : "-", saturated);
+			}
+			
+			string status;
+			if (not health.available) status = "SHOW GLOBAL STATUS failed this cycle";
+			else status = "Uptime " + sec_to_dhms((size_t)health.uptime_s, false, true);
+			out += Mv::to(bottom, x + 1) + string(width - 2, ' ');
+			out += Mv::to(bottom, x + 2) + Theme::c("hi_fg") + "Tab:View  " + Theme::c("graph_text") + status;
+			return out;
+		}
+
+		//* Every realm on one line, the one in the main view taken from the snapshot being drawn
+		static string realms_view(const ::AzerothCore::ServerData& data) {
+			using ::AzerothCore::ServerStatus;
+			string out;
+			int cy = zones_y + 1;
+			const int bottom = zones_y + zones_height - 1;
+			const string main_fg = Theme::c("main_fg");
+			const string title = Theme::c("title");
+			const string inactive = Theme::c("inactive_fg");
+			
+			auto realms = data.realms;
+			const auto watched = ::AzerothCore::realm_watch.summaries();
+			for (size_t i = 0; i < realms.size(); i++) {
+				auto& realm = realms[i];
+				if (not realm.primary) {
+					//? The watchers restart with every realm switch, until then a realm waits
+					if (i < watched.size() and watched[i].name == realm.name and not watched[i].primary) realm = watched[i];
+					continue;
+				}
+				realm.polled = true;
+				realm.status = data.status;
+				realm.bots = data.stats.total;
+				realm.perf = data.stats.perf.available;
+				realm.mean_ms = data.stats.perf.mean;
+				realm.p99_ms = data.stats.perf.p99;
+				realm.error = data.error;
+				realm.updated_ms = 0;
+			}
+			realm_selected = std::clamp(realm_selected, 0, std::max(0, (int)realms.size() - 1));
+			
+			out += Mv::to(cy, x + 4) + title + "Realm";
+			out += Mv::to(cy, x + 20) + "Host";
+			out += Mv::to(cy, x + 42) + "Status";
+			out += Mv::to(cy, x + 54) + rjust("Bots", 7);
+			out += Mv::to(cy, x + 62) + rjust("Mean", 7);
+			out += Mv::to(cy, x + 70) + rjust("p99", 7);
+			out += Mv::to(cy, x + 78) + rjust("Updated", 8);
+			cy++;
+			out += Mv::to(cy++, x + 2) + Theme::c("div_line") + Symbols::h_line * (width - 4);
+			
+			if (realms.size() < 2) {
+				out += Mv::to(cy, x + 4) + inactive + "Only one realm configured, list the others in azerothcore_realms";
+			}
+			const uint64_t now = time_ms();
+			for (size_t i = 0; i < realms.size() and cy < bottom; i++) {
+				const auto& realm = realms[i];
+				string status = "waiting";
+				string status_color = inactive;
+				if (realm.polled) {
+					switch (realm.status) {
+						case ServerStatus::ONLINE: status = "online"; status_color = Theme::c("proc_misc"); break;
+						case ServerStatus::RESTARTING: status = "restarting"; status_color = "\x1b[93m"; break;
+						case ServerStatus::REBUILDING: status = "rebuilding"; status_color = "\x1b[93m"; break;
+						case ServerStatus::ERROR: status = "error"; status_color = title; break;
+						default: status = "offline"; status_color = title; break;
+					}
+				}
+				const bool online = realm.polled and realm.status == ServerStatus::ONLINE;
+				const bool selected = (int)i == realm_selected;
+				string updated = realm.primary ? "shown" : "-";
+				if (not realm.primary and realm.polled) updated = to_string((now - std::min(now, realm.updated_ms)) / 1000) + "s ago";
+				
+				const string row_fg = selected ? Theme::c("hi_fg") : main_fg;
+				out += Mv::to(cy, x + 2) + (realm.primary ? title : row_fg) + (selected ? "► " : "  ") + ljust(realm.name, 15, true);
+				out += Mv::to(cy, x + 20) + row_fg + ljust(realm.host, 21, true);
+				out += Mv::to(cy, x + 42) + status_color + ljust(status, 11);
+				out += Mv::to(cy, x + 54) + row_fg + rjust(online ? to_string(realm.bots) : "-", 7);
+				out += Mv::to(cy, x + 62) + rjust(online and realm.perf ? to_string(realm.mean_ms) + "ms" : "-", 7);
+				out += Mv::to(cy, x + 70) + rjust(online and realm.perf ? to_string(realm.p99_ms) + "ms" : "-", 7);
+				out += Mv::to(cy, x + 78) + (realm.primary ? title : inactive) + rjust(updated, 8);
+				if (not realm.error.empty() and not online and width > 90) {
+					out += Mv::to(cy, x + 88) + inactive + ljust(realm.error, width - 90, true);
+				}
+				cy++;
+			}
+			
+			out += Mv::to(bottom, x + 1) + string(width - 2, ' ');
+			out += Mv::to(bottom, x + 2) + Theme::c("hi_fg") + "Tab:View  Enter:Show  " + Theme::c("graph_text")
+				+ to_string(realms.size()) + (realms.size() == 1 ? " realm" : " realms");
+			return out;
+		}
 
 		string draw(bool force_redraw, [[maybe_unused]] bool data_same) {
 			try {
@@ -1568,10 +1878,12 @@ namespace Draw {
 				if (not shown) return "";
 				if (force_redraw) redraw = true;
 				
-				const auto& data = ::AzerothCore::current_data;
+				// The snapshot stays valid for the whole frame, however long the collector takes with the next
+				const auto snapshot = ::AzerothCore::snapshot();
+				const auto& data = *snapshot;
 				const auto& enabled = ::AzerothCore::enabled;
 				const auto& active = ::AzerothCore::active;
-				const auto& load_hist = ::AzerothCore::load_history;
+				const auto& load_hist = data.load_history;
 				
 			string out;
 			out.reserve(width * height);
@@ -1589,6 +1901,8 @@ namespace Draw {
 					out += Mv::to(clear_y, x + 1) + string(width - 2, ' ');
 				}
 				
+				// The bottom pane title follows the view Tab selected
+				zones_box = createBox(x, zones_y, width, zones_height, Theme::c("proc_box"), true, bottom_title(), "", 10);
 				out += perf_box + dist_box + zones_box;
 				graphs.clear();
 				meters.clear();
@@ -1654,6 +1968,7 @@ namespace Draw {
 		if (data.status == ServerStatus::ONLINE) {
 			out += Theme::c("proc_misc") + "ONLINE " + main_fg + "[" 
 				+ ::AzerothCore::format_uptime(data.stats.uptime_hours) + "]";
+			if (data.eco) out += Theme::c("inactive_fg") + " eco";
 		} else if (data.status == ServerStatus::OFFLINE) {
 			out += Theme::c("title") + "OFFLINE";
 		} else if (data.status == ServerStatus::RESTARTING) {
@@ -1739,7 +2054,59 @@ namespace Draw {
 		} else {
 			out += Theme::c("inactive_fg") + "NOT DETECTED";
 		}
-		
+
+		//* Round-trip time of bottop's own queries against the configured budget
+		if (data.budget.limit_ms > 0) {
+			int budget_pct = (int)(data.budget.used_ms * 100 / data.budget.limit_ms);
+			string budget_color = budget_pct < 50 ? Theme::c("proc_misc") : (budget_pct < 100 ? "\x1b[93m" : "\x1b[91m");
+
+			string budget_display = "RTT Budget: " + budget_color + to_string(budget_pct) + "%" + main_fg
+				+ " (" + to_string(data.budget.used_ms) + "/" + to_string(data.budget.limit_ms) + "ms/min)";
+			if (data.budget.spacing_ms >= 1000) {
+				budget_display += " full every " + to_string(data.budget.spacing_ms / 1000) + "s";
+			}
+			if (data.budget.shed > 0) {
+				budget_display += Theme::c("inactive_fg") + " shed " + to_string(data.budget.shed);
+			}
+
+			out += Mv::to(cy, perf_x + 2) + string(perf_width - 4, ' ');
+			out += Mv::to(cy++, perf_x + 2) + title + budget_display;
+		}
+
+		//* Sampling in use for the distributions
+		if (data.sample.active()) {
+			out += Mv::to(cy, perf_x + 2) + string(perf_width - 4, ' ');
+			out += Mv::to(cy++, perf_x + 2) + title + "Sampled: " + main_fg + "1/" + to_string(data.sample.modulus)
+				+ " (" + to_string(data.sample.sampled) + " of " + to_string(data.sample.population) + " bots)";
+		}
+
+		//* Server-maintained summary table, when installed
+		if (data.summary.installed) {
+			const string state = data.summary.active
+				? "live, " + to_string(data.summary.age_s) + "s old"
+				: "off, " + data.summary.reason;
+			out += Mv::to(cy, perf_x + 2) + string(perf_width - 4, ' ');
+			out += Mv::to(cy++, perf_x + 2) + title + "Summary: " + (data.summary.active ? main_fg : Theme::c("inactive_fg"))
+				+ uresize(state, max(0, perf_width - 13));
+		}
+
+		//* Query cache counters, debug mode only
+		if (Global::debug) {
+			out += Mv::to(cy, perf_x + 2) + string(perf_width - 4, ' ');
+			out += Mv::to(cy++, perf_x + 2) + title + "Cache: " + main_fg + to_string(data.cache.hits) + " hit"
+				+ " " + to_string(data.cache.stale_hits) + " stale " + to_string(data.cache.misses) + " miss "
+				+ to_string(data.cache.coalesced) + " shared";
+		}
+
+		//* Tail-latency control counters, only shown once hedging or timeouts have happened
+		if (data.executor.hedged > 0 || data.executor.timeouts > 0) {
+			out += Mv::to(cy, perf_x + 2) + string(perf_width - 4, ' ');
+			out += Mv::to(cy++, perf_x + 2) + title + "Requests: " + main_fg + to_string(data.executor.requests)
+				+ title + " Hedged: " + main_fg + to_string(data.executor.hedged)
+				+ " (" + to_string(data.executor.hedge_wins) + " won)"
+				+ title + " Timeouts: " + main_fg + to_string(data.executor.timeouts);
+		}
+
 	//* WorldServer Performance Metrics
 		if (data.stats.perf.available || data.stats.update_time_avg > 0) {
 			// Clear the line first to prevent ghosting
@@ -1848,6 +2215,24 @@ namespace Draw {
 						+ graph_lines[i];
 				}
 				cy += graph_height;
+				
+				// Mark the columns holding cycles collected in eco mode, the graph fits two per column
+				out += Mv::to(cy, perf_x + 2) + string(perf_width - 4, ' ');
+				const auto& eco_hist = data.eco_history;
+				if (std::ranges::find(eco_hist, true) != eco_hist.end()) {
+					const size_t per_column = Config::getB(Config::BoolKey::tty_mode) ? 1 : 2;
+					const size_t columns = (eco_hist.size() + per_column - 1) / per_column;
+					string strip;
+					for (size_t column = columns > (size_t)graph_width ? columns - graph_width : 0; column < columns; column++) {
+						// Columns are counted from the newest sample, as the graph does
+						const size_t newest = eco_hist.size() - 1 - (columns - 1 - column) * per_column;
+						bool eco = eco_hist[newest];
+						if (per_column == 2 and newest > 0) eco = eco or eco_hist[newest - 1];
+						strip += eco ? Symbols::h_line : " ";
+					}
+					out += Mv::to(cy, perf_x + 2) + Theme::c("inactive_fg") + rjust("eco", scale_width - 1) + " "
+						+ Mv::r(graph_width - (int)ulen(strip)) + strip;
+				}
 				} catch (const std::exception& e) {
 					out += Mv::to(cy, perf_x + 4) + Theme::c("inactive_fg") + "Graph error: " + string(e.what());
 					cy++;
@@ -1865,6 +2250,12 @@ namespace Draw {
 	for (int clear_line = 0; clear_line < dist_height - 2; clear_line++) {
 		out += Mv::to(dist_y + 1 + clear_line, dist_x + 1) + string(dist_width - 2, ' ');
 	}
+	
+	//* Error bar for sampled percentages, "±0.4" after the value when there is room
+	auto error_bar = [&](double margin) -> string {
+		if (margin <= 0.0 or dist_width < 28) return "";
+		return Theme::c("inactive_fg") + " ±" + fmt::format("{:.1f}", margin);
+	};
 		
 		// Faction distribution - colored text only, no bars
 		if (!data.factions.empty() and dist_cy < dist_y + dist_height - 1) {
@@ -1884,7 +2275,7 @@ namespace Draw {
 				
 				string percent_str = to_string((int)faction.percent) + "%";
 				out += Mv::to(dist_cy, dist_x + 2) + faction_color + ljust(faction.name, 15);
-				out += faction_color + rjust(percent_str, 4);
+				out += faction_color + rjust(percent_str, 4) + error_bar(faction.margin);
 				dist_cy++;
 			}
 		}
@@ -1898,11 +2289,11 @@ namespace Draw {
 				// Find expected percentage from server config for color indicator
 				double expected_percent = 0.0;
 				bool has_expected = false;
-				if (::AzerothCore::expected_values.loaded) {
-					auto exp_it = std::find_if(::AzerothCore::expected_values.continent_distribution.begin(),
-					                            ::AzerothCore::expected_values.continent_distribution.end(),
+				if (data.expected.loaded) {
+					auto exp_it = std::find_if(data.expected.continent_distribution.begin(),
+					                            data.expected.continent_distribution.end(),
 					                            [&continent](const auto& c) { return c.name == continent.name; });
-					if (exp_it != ::AzerothCore::expected_values.continent_distribution.end()) {
+					if (exp_it != data.expected.continent_distribution.end()) {
 						expected_percent = exp_it->percent;
 						has_expected = true;
 					}
@@ -1930,7 +2321,7 @@ namespace Draw {
 				
 				string percent_str = to_string((int)continent.percent) + "%";
 				out += Mv::to(dist_cy, dist_x + 2) + title + ljust(continent.name, 15);
-				out += line_color + rjust(percent_str, 4);
+				out += line_color + rjust(percent_str, 4) + error_bar(continent.margin);
 				dist_cy++;
 			}
 		}
@@ -1940,7 +2331,7 @@ namespace Draw {
 				out += Mv::to(dist_cy++, dist_x + 2) + title + "Levels:";
 				
 				// Get bracket definitions from loaded config (or use defaults)
-				const auto& bracket_defs = ::AzerothCore::expected_values.bracket_definitions;
+				const auto& bracket_defs = data.expected.bracket_definitions;
 				
 				// If no brackets loaded yet, use defaults
 				std::vector<std::string> bracket_names;
@@ -1950,6 +2341,11 @@ namespace Draw {
 					for (const auto& def : bracket_defs) {
 						bracket_names.push_back(def.range);
 					}
+					// Horde-only ranges when the factions use different layouts
+					for (const auto& def : data.expected.horde_bracket_definitions) {
+						if (std::find(bracket_names.begin(), bracket_names.end(), def.range) == bracket_names.end())
+							bracket_names.push_back(def.range);
+					}
 				}
 				
 				// Display all brackets in order
@@ -1961,15 +2357,16 @@ namespace Draw {
 						[&bracket_name](const auto& lb) { return lb.range == bracket_name; });
 		
 		double percent = (it != data.levels.end()) ? it->percent : 0.0;
+		double margin = (it != data.levels.end()) ? it->margin : 0.0;
 		
 		// Find expected percentage from server config for color indicator
 		double expected_percent = 0.0;
 		bool has_expected = false;
-		if (::AzerothCore::expected_values.loaded) {
-			auto exp_it = std::find_if(::AzerothCore::expected_values.level_distribution.begin(),
-			                            ::AzerothCore::expected_values.level_distribution.end(),
+		if (data.expected.loaded) {
+			auto exp_it = std::find_if(data.expected.level_distribution.begin(),
+			                            data.expected.level_distribution.end(),
 			                            [&bracket_name](const auto& lb) { return lb.range == bracket_name; });
-			if (exp_it != ::AzerothCore::expected_values.level_distribution.end()) {
+			if (exp_it != data.expected.level_distribution.end()) {
 				expected_percent = exp_it->percent;
 				has_expected = true;
 			}
@@ -1999,7 +2396,7 @@ namespace Draw {
 		string percent_str = to_string((int)percent) + "%";
 		
 		out += Mv::to(dist_cy, dist_x + 2) + title + bracket_str;
-		out += line_color + rjust(percent_str, 4);
+		out += line_color + rjust(percent_str, 4) + error_bar(margin);
 		dist_cy++;
 	}
 }
@@ -2013,6 +2410,17 @@ namespace Draw {
 	}
 	cy = zones_y + 1;  // Reset cy after clearing
 	
+	if (bottom_view != BottomView::ZONES) {
+		if (bottom_view == BottomView::TABLES) out += tables_view(data.tables);
+		else if (bottom_view == BottomView::LOCKS) out += locks_view(data);
+		else if (bottom_view == BottomView::HEALTH) out += health_view(data.health);
+		else out += realms_view(data);
+		if (!data.timestamp.empty()) {
+			out += Mv::to(zones_y + zones_height - 1, x + width - 20) + Theme::c("graph_text") + data.timestamp;
+		}
+		return out;
+	}
+	
 	//* Auto-expand all continents on first run
 	static bool first_run = true;
 	if (first_run && !data.zones.empty()) {
@@ -2134,8 +2542,33 @@ for (size_t sorted_idx = 0; sorted_idx < sorted_indices.size(); sorted_idx++) {
 	
 	// Simply add the zone to the display list (no continent/region grouping)
 	zone_display_list.push_back({Draw::AzerothCore::DisplayItem::ZONE, orig_idx, zone.name});
+	
+	// Bots of the expanded zone, only the rows loaded so far, then a placeholder for the next page.
+	// Matched by zone id, zone indices move when a new cycle re-sorts the zones.
+	if (::AzerothCore::bot_list.zone_id() == zone.zone_id) {
+		const size_t loaded = ::AzerothCore::bot_list.size();
+		for (size_t row = 0; row < loaded; row++) {
+			zone_display_list.push_back({Draw::AzerothCore::DisplayItem::BOT, orig_idx, "", row});
+		}
+		if (not ::AzerothCore::bot_list.complete()) {
+			zone_display_list.push_back({Draw::AzerothCore::DisplayItem::LOADING, orig_idx, "", loaded});
+		}
+	}
 	}
 			
+		// Select the zone a search result jumped to, now that the list is built
+		if (pending_zone_jump >= 0) {
+			for (size_t i = 0; i < zone_display_list.size(); i++) {
+				const auto& item = zone_display_list[i];
+				if (item.type == Draw::AzerothCore::DisplayItem::ZONE and data.zones[item.zone_index].zone_id == pending_zone_jump) {
+					selected_zone = (int)i;
+					zone_selection_active = true;
+					break;
+				}
+			}
+			pending_zone_jump = -1;
+		}
+		
 		// Clamp selected zone to display list bounds
 		if (selected_zone >= (int)zone_display_list.size()) {
 			selected_zone = max(0, (int)zone_display_list.size() - 1);
@@ -2169,8 +2602,31 @@ for (size_t sorted_idx = 0; sorted_idx < sorted_indices.size(); sorted_idx++) {
 	out += Mv::to(cy, x + 34) + Theme::c("hi_fg") + rjust(to_string(total_bots), 6);
 	cy++;
 		
+			//* Name search results take the place of the zone list while the prompt is open
+			if (name_searching) {
+				auto index = ::AzerothCore::name_index();
+				auto matches = index->search(name_search.text, zone_select_max);
+				name_selected = clamp(name_selected, 0, max(0, (int)matches.size() - 1));
+				for (size_t i = 0; i < matches.size() and cy < zones_y + zones_height - 2; i++) {
+					const auto& bot = matches[i].entry;
+					bool is_selected = (int)i == name_selected;
+					string row_fg = is_selected ? Theme::c("hi_fg") : main_fg;
+					out += Mv::to(cy, x + 2) + row_fg + (is_selected ? "► " : "  ") + ljust(bot.name, 14)
+						+ rjust(to_string(bot.level), 3) + "  " + (is_selected ? row_fg : Theme::c("inactive_fg"))
+						+ ::AzerothCore::get_zone_name(bot.zone);
+					cy++;
+				}
+				if (matches.empty()) {
+					out += Mv::to(cy, x + 4) + Theme::c("inactive_fg")
+						+ (name_search.text.empty() ? "Type part of a name, " + to_string(index->size()) + " online bots indexed" : "No online bot matches");
+				}
+				
+				out += Mv::to(zones_y + zones_height - 1, x + 1) + string(width - 2, ' ');
+				out += Mv::to(zones_y + zones_height - 1, x + 2) + Theme::c("hi_fg") + "Search: " + name_search.text + "_"
+					+ Theme::c("graph_text") + "  ↑↓:Select  Enter:Jump  Esc:Cancel";
+			}
 			//* Zone list (hierarchical by Continent > Region > Zone)
-			if (!data.zones.empty() && !zone_display_list.empty()) {
+			else if (!data.zones.empty() && !zone_display_list.empty()) {
 				int displayed_rows = 0;
 				size_t list_height = zone_select_max;
 				
@@ -2190,6 +2646,8 @@ for (size_t sorted_idx = 0; sorted_idx < sorted_indices.size(); sorted_idx++) {
 				int max_scroll = max(0, (int)zone_display_list.size() - (int)list_height);
 				zone_scroll_offset = clamp(zone_scroll_offset, 0, max_scroll);
 				
+				// Only visible bot rows are formatted, the furthest one drives prefetching
+				std::optional<size_t> last_bot_row;
 				for (size_t display_idx = zone_scroll_offset; display_idx < zone_display_list.size(); display_idx++) {
 					// Check if we have room to display
 					if (cy >= zones_y + zones_height - 2) break;
@@ -2240,10 +2698,32 @@ for (size_t sorted_idx = 0; sorted_idx < sorted_indices.size(); sorted_idx++) {
 					
 					out += Mv::to(cy, x + 71) + align_color 
 						+ rjust(to_string((int)zone.alignment), 3) + "%";
+					if (zone.alignment_margin > 0.0 and width >= 84) {
+						out += Theme::c("inactive_fg") + " ±" + to_string((int)std::ceil(zone.alignment_margin));
+					}
+					cy++;
+					displayed_rows++;
+				}
+				else if (item.type == Draw::AzerothCore::DisplayItem::BOT or item.type == Draw::AzerothCore::DisplayItem::LOADING) {
+					string row_fg = is_selected ? Theme::c("hi_fg") : main_fg;
+					out += Mv::to(cy, x + 2) + string(width - 4, ' ') + Mv::to(cy, x + 2) + row_fg + (is_selected ? "► " : "  ");
+					auto bot = (item.type == Draw::AzerothCore::DisplayItem::BOT) ? ::AzerothCore::bot_list.row(item.row) : std::nullopt;
+					if (bot) {
+						out += Theme::c("inactive_fg") + "  " + row_fg + ljust(bot->name, 13) + rjust(to_string(bot->level), 3) + "  "
+							+ ljust(::AzerothCore::class_name(bot->class_id), 13) + ljust(::AzerothCore::race_name(bot->race), 10)
+							+ Theme::c("inactive_fg") + "acct " + rjust(to_string(bot->account), 6);
+						string dev_color = bot->deviation == 0 ? Theme::c("proc_misc") : (std::abs(bot->deviation) <= 5 ? "\x1b[93m" : Theme::c("title"));
+						out += Mv::to(cy, x + 71) + dev_color + (bot->deviation == 0 ? rjust("ok", 4) : rjust((bot->deviation > 0 ? "+" : "") + to_string(bot->deviation), 4));
+					}
+					else {
+						out += Theme::c("inactive_fg") + "  loading...";
+					}
+					last_bot_row = item.row;
 					cy++;
 					displayed_rows++;
 				}
 				}
+				if (last_bot_row) ::AzerothCore::bot_list.want(*last_bot_row);
 				
 			// Navigation help (clear bottom line first to prevent ghosting)
 			out += Mv::to(zones_y + zones_height - 1, x + 1) + string(width - 2, ' ');
@@ -2254,7 +2734,7 @@ for (size_t sorted_idx = 0; sorted_idx < sorted_indices.size(); sorted_idx++) {
 			}
 		else if (zone_selection_active) {
 			out += Mv::to(zones_y + zones_height - 1, x + 2) + Theme::c("hi_fg") 
-				+ "↑↓:Nav  PgUp/PgDn:FastScroll  Home/End:Jump  n/b/m/M/a:Sort  r:Reverse  f:Filter";
+				+ "↑↓:Nav  PgUp/PgDn:FastScroll  Home/End:Jump  →:Bots  n/b/m/M/a:Sort  r:Reverse  f:Filter  /:Search  c:Pivot  Tab:View";
 		} else {
 				out += Mv::to(zones_y + zones_height - 1, x + 2) + Theme::c("graph_text") 
 					+ "Arrow keys to navigate zones";
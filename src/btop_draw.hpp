@@ -169,10 +169,11 @@ namespace Draw {
 		
 		//* Display list for zone navigation
 		struct DisplayItem {
-			enum Type { CONTINENT, REGION, ZONE };
+			enum Type { CONTINENT, REGION, ZONE, BOT, LOADING };
 			Type type;
-			size_t zone_index;  // Index in data.zones (only for ZONE type)
+			size_t zone_index;  // Index in data.zones (ZONE, and the expanded zone for BOT and LOADING)
 			string name;
+			size_t row = 0;     // Index in AzerothCore::bot_list (BOT and LOADING)
 		};
 		extern std::vector<DisplayItem> zone_display_list;
 		
@@ -180,12 +181,22 @@ namespace Draw {
 		extern int selected_zone;
 		extern bool zone_selection_active;
 		extern bool zone_filtering;                // Whether zone filter is active
+		extern Draw::TextEdit name_search;         // Search prompt over online bot names
+		extern bool name_searching;                // Whether the search prompt is open
+		extern int name_selected;                  // Highlighted search result
+		extern int realm_selected;                 // Highlighted row of the realms view
+		extern int pending_zone_jump;              // Zone id to select on the next draw, -1 for none
 		extern std::set<size_t> expanded_zones;
 		extern std::set<std::string> expanded_continents;  // Track which continents are expanded
 		
 		//* Zone scrolling
 		extern int zone_scroll_offset;  // First visible line in zones list
 		
+		//* Bottom pane views, Tab cycles through them
+		enum class BottomView { ZONES, TABLES, LOCKS, HEALTH, REALMS };
+		extern BottomView bottom_view;
+		string bottom_title();
+		
 		//* Zone sorting
 		enum class ZoneSortColumn { NONE, NAME, BOTS, MIN_LEVEL, MAX_LEVEL, ALIGNMENT };
 		extern ZoneSortColumn zone_sort_column;
@@ -199,6 +210,10 @@ namespace Draw {
 		//* Graph tracking
 		extern long long last_graph_max;
 		
+		//* Whether the published snapshot has another number of brackets than the pane heights were sized for
+		extern size_t layout_brackets;             // Bracket count calcSizes() sized the distribution pane for
+		bool layout_stale();
+		
 		string draw(bool force_redraw = false, bool data_same = false);
 	}
 }
@@ -0,0 +1,135 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include <array>
+#include <cerrno>
+#include <ctime>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "btop_events.hpp"
+
+namespace Events {
+
+	namespace {
+		int epoll_fd = -1;
+		int tick_fd = -1;
+		int clock_fd = -1;
+		int resize_fd = -1;
+		int signal_fd = -1;
+		uint64_t tick_period_ms = 0;
+		bool clock_enabled = false;
+
+		bool add(int fd) {
+			epoll_event event{};
+			event.events = EPOLLIN;
+			event.data.fd = fd;
+			return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+		}
+
+		//* Absolute realtime timer on the next multiple of period_ms, cancelled when the clock is set
+		void arm(int fd, uint64_t period_ms) {
+			itimerspec spec{};
+			if (period_ms > 0) {
+				timespec now{};
+				clock_gettime(CLOCK_REALTIME, &now);
+				const uint64_t now_ms = (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+				const uint64_t next_ms = (now_ms / period_ms + 1) * period_ms;
+				spec.it_value = {(time_t)(next_ms / 1000), (long)(next_ms % 1000) * 1000000};
+				spec.it_interval = {(time_t)(period_ms / 1000), (long)(period_ms % 1000) * 1000000};
+			}
+			timerfd_settime(fd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &spec, nullptr);
+		}
+
+		//* Expirations since the last read, -1 when the wall clock was set meanwhile
+		int64_t expirations(int fd) {
+			uint64_t count = 0;
+			if (read(fd, &count, sizeof(count)) == sizeof(count)) return (int64_t)count;
+			return errno == ECANCELED ? -1 : 0;
+		}
+	}
+
+	bool init(std::initializer_list<int> signals) {
+		epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		tick_fd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+		clock_fd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+		resize_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		sigset_t mask;
+		sigemptyset(&mask);
+		for (int sig : signals) sigaddset(&mask, sig);
+		signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+		if (epoll_fd < 0 or tick_fd < 0 or clock_fd < 0 or resize_fd < 0 or signal_fd < 0) return false;
+		return add(STDIN_FILENO) and add(tick_fd) and add(clock_fd) and add(resize_fd) and add(signal_fd);
+	}
+
+	void arm_tick(uint64_t period_ms) {
+		tick_period_ms = period_ms;
+		arm(tick_fd, period_ms);
+	}
+
+	void arm_clock(bool enabled) {
+		if (enabled == clock_enabled) return;
+		clock_enabled = enabled;
+		arm(clock_fd, enabled ? 1000 : 0);
+	}
+
+	void arm_resize(uint64_t delay_ms) {
+		itimerspec spec{};
+		spec.it_value = {(time_t)(delay_ms / 1000), (long)(delay_ms % 1000) * 1000000};
+		timerfd_settime(resize_fd, 0, &spec, nullptr);
+	}
+
+	void watch(int fd) {
+		if (fd >= 0) add(fd);
+	}
+
+	Ready wait() {
+		Ready ready;
+		std::array<epoll_event, 8> events;
+		//? A handler that ran meanwhile (SIGINT, SIGTSTP) left flags for the caller, so EINTR returns empty
+		const int count = epoll_wait(epoll_fd, events.data(), (int)events.size(), -1);
+
+		for (int i = 0; i < count; i++) {
+			const int fd = events[i].data.fd;
+			if (fd == STDIN_FILENO) ready.input = true;
+			else if (fd == tick_fd or fd == clock_fd) {
+				const int64_t fired = expirations(fd);
+				if (fired < 0) ready.clock_set = true;
+				else if (fired > 0) (fd == tick_fd ? ready.tick : ready.clock) = true;
+			}
+			else if (fd == resize_fd) ready.resize = expirations(fd) > 0;
+			else if (fd == signal_fd) {
+				signalfd_siginfo info;
+				while (read(signal_fd, &info, sizeof(info)) == sizeof(info)) ready.signals.push_back((int)info.ssi_signo);
+			}
+			else ready.watched.push_back(fd);
+		}
+
+		//? A set clock cancels both timers, new boundaries are taken from the new time
+		if (ready.clock_set) {
+			arm(tick_fd, tick_period_ms);
+			if (clock_enabled) arm(clock_fd, 1000);
+			ready.tick = ready.clock = true;
+		}
+		return ready;
+	}
+
+}
@@ -0,0 +1,61 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+//* Event loop of the main thread: one epoll set over stdin, data tick, clock and resize timerfds, a signalfd
+//* and any other file descriptor a module wants watched. The main loop sleeps in wait() until one of
+//* them is ready, it never wakes up on a timeout of its own.
+namespace Events {
+
+	//* What wait() found ready, all of it is handled before the next wait
+	struct Ready {
+		bool input = false;       // stdin is readable
+		bool tick = false;        // A data tick passed, missed ticks fold into one
+		bool clock = false;       // The clock second changed
+		bool clock_set = false;   // The wall clock was changed, timers were re-armed
+		bool resize = false;      // The delay given to arm_resize() passed
+		std::vector<int> signals; // Signals taken from the signalfd
+		std::vector<int> watched; // Watched fds that became readable
+	};
+
+	//* Create the epoll set. signals must already be blocked in every thread, they are read from a
+	//* signalfd instead of running their handlers. Returns false when the kernel lacks any of it.
+	bool init(std::initializer_list<int> signals);
+
+	//* Fire a tick every period_ms on multiples of period_ms of the wall clock, so samples taken on
+	//* ticks line up with the seconds on the clock and are evenly spaced. 0 stops the ticks.
+	void arm_tick(uint64_t period_ms);
+
+	//* Fire a clock event on every full second while enabled
+	void arm_clock(bool enabled);
+
+	//* Report Ready::resize once, delay_ms from now. Arming it again moves it out, 0 cancels it.
+	void arm_resize(uint64_t delay_ms);
+
+	//* Report fd in Ready::watched when readable, the owner reads it
+	void watch(int fd);
+
+	//* Block until something is ready. Returns with nothing ready when a signal handler ran meanwhile.
+	Ready wait();
+
+}
@@ -82,7 +82,9 @@ namespace Input {
 		{"[20~",	"f9"},
 		{"[21~",	"f10"},
 		{"[23~",	"f11"},
-		{"[24~",	"f12"}
+		{"[24~",	"f12"},
+		{"[I",		"focus_in"},
+		{"[O",		"focus_out"}
 	};
 
 	sigset_t signal_mask;
@@ -215,8 +217,14 @@ namespace Input {
 		auto vim_keys = Config::getB("vim_keys");
 		// auto help_key = (vim_keys ? "H" : "h");  // Unused in bottop
 		// auto kill_key = (vim_keys ? "K" : "k");  // Unused after stock box removal
+	#ifdef AZEROTHCORE_SUPPORT
+		//? q, m and escape are text or close the prompt while searching names
+		const bool text_input = Draw::AzerothCore::name_searching;
+	#else
+		const bool text_input = false;
+	#endif
 		//? Global input actions
-		if (not filtering) {
+		if (not filtering and not text_input) {
 			bool keep_going = false;
 			if (key == "q") {
 				clean_quit(0);
@@ -290,6 +298,63 @@ namespace Input {
 			#ifdef AZEROTHCORE_SUPPORT
 			//? Input actions for AzerothCore zone navigation - arrow keys always work
 			if (Draw::AzerothCore::shown and not filtering) {
+				// The name search prompt takes every key while open
+				if (Draw::AzerothCore::name_searching) {
+					if (key == "escape") {
+						Draw::AzerothCore::name_searching = false;
+					}
+					else if (key == "enter") {
+						auto matches = AzerothCore::name_index()->search(Draw::AzerothCore::name_search.text, Draw::AzerothCore::zone_select_max);
+						if (Draw::AzerothCore::name_selected < (int)matches.size()) {
+							Draw::AzerothCore::pending_zone_jump = matches[Draw::AzerothCore::name_selected].entry.zone;
+							// The zone must be in the list to be selected
+							Draw::AzerothCore::zone_filter.clear();
+						}
+						Draw::AzerothCore::name_searching = false;
+					}
+					else if (key == "up") {
+						if (Draw::AzerothCore::name_selected > 0) Draw::AzerothCore::name_selected--;
+					}
+					else if (key == "down") {
+						Draw::AzerothCore::name_selected++;  // Clamped to the results when drawn
+					}
+					else if (Draw::AzerothCore::name_search.command(key)) {
+						Draw::AzerothCore::name_selected = 0;
+					}
+					Draw::AzerothCore::redraw = true;
+					return;
+				}
+				else if (key == "tab" and not Draw::AzerothCore::zone_filtering) {
+					using Draw::AzerothCore::BottomView;
+					auto& view = Draw::AzerothCore::bottom_view;
+					view = (view == BottomView::REALMS) ? BottomView::ZONES : static_cast<BottomView>(static_cast<int>(view) + 1);
+					Draw::AzerothCore::redraw = true;
+					return;
+				}
+				else if (Draw::AzerothCore::bottom_view == Draw::AzerothCore::BottomView::REALMS
+						and (key == "up" or key == "down" or key == "enter" or (vim_keys and (key == "k" or key == "j")))) {
+					// The realms view takes the arrows, Enter shows the highlighted realm in the main view
+					if (key == "up" or key == "k") {
+						if (Draw::AzerothCore::realm_selected > 0) Draw::AzerothCore::realm_selected--;
+					}
+					else if (key == "down" or key == "j") {
+						Draw::AzerothCore::realm_selected++;  // Clamped to the realms when drawn
+					}
+					else {
+						AzerothCore::switch_realm((size_t)Draw::AzerothCore::realm_selected);
+						Draw::AzerothCore::bottom_view = Draw::AzerothCore::BottomView::ZONES;
+					}
+					Draw::AzerothCore::redraw = true;
+					return;
+				}
+				else if (key == "/" and not Draw::AzerothCore::zone_filtering) {
+					Draw::AzerothCore::name_searching = true;
+					Draw::AzerothCore::name_search.clear();
+					Draw::AzerothCore::name_selected = 0;
+					Draw::AzerothCore::redraw = true;
+					return;
+				}
+				
 				if (key == "up" or (vim_keys and key == "k")) {
 					// Auto-activate zone navigation on first use
 					if (not Draw::AzerothCore::zone_selection_active) {
@@ -330,15 +395,25 @@ namespace Input {
 								Draw::AzerothCore::redraw = true;
 							}
 						}
+						else if (item.type == Draw::AzerothCore::DisplayItem::BOT or item.type == Draw::AzerothCore::DisplayItem::LOADING) {
+							// Collapse the zone the bot list belongs to and go back to its row
+							Draw::AzerothCore::expanded_zones.erase(item.zone_index);
+							AzerothCore::bot_list.close();
+							Draw::AzerothCore::selected_zone = std::max(0, idx - (int)item.row - 1);
+							Draw::AzerothCore::redraw = true;
+						}
 						else if (item.type == Draw::AzerothCore::DisplayItem::ZONE) {
 							// First try to collapse the zone if expanded
 							if (Draw::AzerothCore::expanded_zones.contains(item.zone_index)) {
 								Draw::AzerothCore::expanded_zones.erase(item.zone_index);
+								AzerothCore::bot_list.close();
 								Draw::AzerothCore::redraw = true;
 							}
 							// Otherwise collapse the continent
 							else {
-								const auto& zone = AzerothCore::current_data.zones[item.zone_index];
+								const auto data = AzerothCore::snapshot();
+								if (item.zone_index >= data->zones.size()) return;
+								const auto& zone = data->zones[item.zone_index];
 								if (Draw::AzerothCore::expanded_continents.contains(zone.continent)) {
 									Draw::AzerothCore::expanded_continents.erase(zone.continent);
 									Draw::AzerothCore::redraw = true;
@@ -367,7 +442,9 @@ namespace Input {
 						}
 					}
 					else if (item.type == Draw::AzerothCore::DisplayItem::ZONE) {
-						const auto& zone = AzerothCore::current_data.zones[item.zone_index];
+						const auto data = AzerothCore::snapshot();
+						if (item.zone_index >= data->zones.size()) return;
+						const auto& zone = data->zones[item.zone_index];
 						
 						// If continent is collapsed, expand it first
 						if (!Draw::AzerothCore::expanded_continents.contains(zone.continent)) {
@@ -379,19 +456,12 @@ namespace Input {
 						// Continent is expanded, toggle zone expansion
 						if (Draw::AzerothCore::expanded_zones.contains(item.zone_index)) {
 							Draw::AzerothCore::expanded_zones.erase(item.zone_index);
+							AzerothCore::bot_list.close();
 						} else {
-							// Load zone details if not already loaded
-							auto& mutable_zone = AzerothCore::current_data.zones[item.zone_index];
-							if (mutable_zone.details.empty() && AzerothCore::query) {
-								try {
-									mutable_zone.details = AzerothCore::query->fetch_zone_details(mutable_zone.zone_id);
-									Logger::debug("Loaded " + std::to_string(mutable_zone.details.size()) + 
-									              " location clusters for zone: " + mutable_zone.name);
-								} catch (const std::exception& e) {
-									Logger::error("Failed to fetch zone details: " + std::string(e.what()));
-								}
-							}
+							// One bot list at a time, expanding a zone moves it there
+							Draw::AzerothCore::expanded_zones.clear();
 							Draw::AzerothCore::expanded_zones.insert(item.zone_index);
+							AzerothCore::bot_list.open(zone.zone_id, zone.expected_min, zone.expected_max);
 						}
 					Draw::AzerothCore::redraw = true;
 				}
@@ -467,6 +537,14 @@ namespace Input {
 				Draw::AzerothCore::redraw = true;
 				return;
 			}
+			else if (key == "A" and not Draw::AzerothCore::zone_filtering) {
+				Menu::show(Menu::Menus::Advise);
+				return;
+			}
+			else if (key == "c" and not Draw::AzerothCore::zone_filtering) {
+				Menu::show(Menu::Menus::Pivot);
+				return;
+			}
 			else if (key == "f" and not Draw::AzerothCore::zone_filtering) {
 				// Activate filter mode
 				Draw::AzerothCore::zone_filtering = true;
@@ -503,7 +581,8 @@ namespace Input {
 				bool redraw = true;
 				
 				if (is_in(key, "up", "down", "page_up", "page_down", "home", "end") or (vim_keys and is_in(key, "j", "k", "g", "G"))) {
-					const auto& zones = AzerothCore::current_data.zones;
+					const auto data = AzerothCore::snapshot();
+					const auto& zones = data->zones;
 					size_t total_zones = zones.size();
 					
 					if (total_zones > zone_select_max) {
@@ -23,6 +23,9 @@ tab-size = 4
 #include "btop_shared.hpp"
 #include "btop_theme.hpp"
 #include "btop_tools.hpp"
+#ifdef AZEROTHCORE_SUPPORT
+#include "btop_azerothcore.hpp"
+#endif
 
 #include <errno.h>
 #include <signal.h>
@@ -1069,6 +1072,109 @@ namespace Menu {
 		return NoChange;
 	}
 
+	//* Index advisor report for the collection queries. The collector runs the EXPLAINs once the menu
+	//* asked for them, the menu shows the report of the first snapshot that has it.
+	static int adviseMenu(const string& key) {
+	#ifdef AZEROTHCORE_SUPPORT
+		static uint64_t request = 0;  // Asked for when the menu opened, 0 when monitoring is not running
+		static bool shown = false;    // The report is drawn, not the placeholder
+		const auto data = ::AzerothCore::snapshot();
+		if (redraw and not shown and request == 0 and ::AzerothCore::active) request = ::AzerothCore::request_advice();
+		const bool arrived = request > 0 and data->advice and data->advice_request >= request;
+		if (arrived and not shown) redraw = true;
+	#endif
+		if (redraw) {
+			vector<string> cont_vec;
+		#ifdef AZEROTHCORE_SUPPORT
+			if (arrived) {
+				shown = true;
+				const size_t max_lines = max(1, Term::height - 8);
+				for (const auto& line : data->advice->lines(false)) {
+					if (cont_vec.size() == max_lines) break;
+					cont_vec.push_back(Theme::c("main_fg") + ljust(line, 74) + Fx::reset);
+				}
+			}
+			else if (request > 0)
+				cont_vec.push_back(Theme::c("main_fg") + "Running EXPLAIN on the collection queries..." + Fx::reset);
+			else
+		#endif
+				cont_vec.push_back(Theme::c("main_fg") + "AzerothCore monitoring is not running" + Fx::reset);
+
+			messageBox = Menu::msgBox{78, 0, cont_vec, "advise"};
+			Global::overlay = messageBox();
+		}
+
+		auto ret = messageBox.input(key);
+		if (ret == msgBox::Ok_Yes or ret == msgBox::No_Esc) {
+			messageBox.clear();
+		#ifdef AZEROTHCORE_SUPPORT
+			request = 0;
+			shown = false;
+		#endif
+			return Closed;
+		}
+		else if (redraw) {
+			return Changed;
+		}
+		return NoChange;
+	}
+
+	static int pivotMenu(const string& key) {
+	#ifdef AZEROTHCORE_SUPPORT
+		static int view = 0;
+		if (is_in(key, "right", "tab")) {
+			view = (view + 1) % ::AzerothCore::PIVOT_VIEWS;
+			redraw = true;
+		}
+		else if (is_in(key, "left", "shift_tab")) {
+			view = (view + ::AzerothCore::PIVOT_VIEWS - 1) % ::AzerothCore::PIVOT_VIEWS;
+			redraw = true;
+		}
+	#endif
+		if (redraw) {
+			vector<string> cont_vec;
+		#ifdef AZEROTHCORE_SUPPORT
+			const auto data = ::AzerothCore::snapshot();
+			const auto& cube = data->cube;
+			const auto& sample = data->sample;
+			if (cube and not cube->empty()) {
+				//? Rolled up from the last collected cube, switching views never queries the server
+				auto table = ::AzerothCore::pivot(*cube, static_cast<::AzerothCore::PivotView>(view), data->expected, sample.active() ? sample.scale() : 1.0);
+				cont_vec.push_back(Fx::b + Theme::c("title") + ljust(table.title + (sample.active() ? " (~ sampled)" : ""), 64)
+					+ Theme::c("inactive_fg") + rjust(to_string(view + 1) + "/" + to_string(::AzerothCore::PIVOT_VIEWS) + " ←→", 10, true) + Fx::reset);
+				string header = Theme::c("hi_fg") + ljust("", 18) + rjust("Bots", 6);
+				for (const auto& column : table.columns) header += rjust(column, 5);
+				cont_vec.push_back(header + Fx::reset);
+				const size_t max_rows = max(1, Term::height - 10);
+				for (const auto& row : table.rows) {
+					if (cont_vec.size() - 2 == max_rows) break;
+					string line = Theme::c("main_fg") + ljust(row.label, 17, true) + ' ' + rjust(to_string(row.total), 6);
+					for (int cell : row.cells) {
+						const int percent = (int)std::lround(cell * 100.0 / row.total);
+						line += (cell == 0 ? Theme::c("inactive_fg") + rjust("-", 5) : Theme::c("main_fg") + rjust(to_string(percent) + '%', 5));
+					}
+					cont_vec.push_back(line + Fx::reset);
+				}
+			}
+			else
+		#endif
+				cont_vec.push_back(Theme::c("main_fg") + "No bot data collected yet" + Fx::reset);
+
+			messageBox = Menu::msgBox{78, 0, cont_vec, "pivot"};
+			Global::overlay = messageBox();
+		}
+
+		auto ret = messageBox.input(key);
+		if (ret == msgBox::Ok_Yes or ret == msgBox::No_Esc) {
+			messageBox.clear();
+			return Closed;
+		}
+		else if (redraw) {
+			return Changed;
+		}
+		return NoChange;
+	}
+
 	static int signalSend(const string& key) {
 		auto s_pid = (Config::getB("show_detailed") and Config::getI("selected_pid") == 0 ? Config::getI("detailed_pid") : Config::getI("selected_pid"));
 		if (s_pid == 0) return Closed;
@@ -1735,9 +1841,11 @@ static int optionsMenu(const string& key) {
 		ref(optionsMenu),
 		ref(helpMenu),
 		ref(reniceMenu),
+		ref(adviseMenu),
+		ref(pivotMenu),
 		ref(mainMenu),
 	};
-	bitset<8> menuMask;
+	bitset<10> menuMask;
 
 	void process(const std::string_view key) {
 		if (menuMask.none()) {
@@ -1756,7 +1864,7 @@ static int optionsMenu(const string& key) {
 		if (currentMenu < 0 or not menuMask.test(currentMenu)) {
 			Menu::active = true;
 			redraw = true;
-			if (((menuMask.test(Main) or menuMask.test(Options) or menuMask.test(Help) or menuMask.test(SignalChoose))
+			if (((menuMask.test(Main) or menuMask.test(Options) or menuMask.test(Help) or menuMask.test(SignalChoose) or menuMask.test(Advise) or menuMask.test(Pivot))
 			and (Term::width < 80 or Term::height < 24))
 			or (Term::width < 50 or Term::height < 20)) {
 				menuMask.reset();
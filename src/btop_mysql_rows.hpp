@@ -0,0 +1,174 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+//* Zero-copy decoder for the tab separated output of `mysql -sN`.
+//* The row shape is a template parameter, e.g. `for (auto row : Mysql::rows<int, int>(result))`,
+//* every row decodes to std::expected so a malformed row can be skipped without throwing.
+//* std::string_view fields point into the decoded text, which must outlive them.
+namespace Mysql {
+
+	enum class RowError {
+		MissingField,  // Fewer tab separated fields than the row shape
+		ExtraField,    // More fields than the row shape
+		BadValue       // Field not convertible to its type (includes NULL for numbers)
+	};
+
+	//* Convert a single field, numbers must be consumed entirely
+	template<typename T>
+	inline std::expected<T, RowError> parse_field(std::string_view field) {
+		if constexpr (std::is_same_v<T, std::string_view>) {
+			return field;
+		}
+		else {
+			static_assert(std::is_arithmetic_v<T>, "Mysql::rows fields must be arithmetic or std::string_view");
+			T value{};
+			const char* last = field.data() + field.size();
+			auto [ptr, ec] = std::from_chars(field.data(), last, value);
+			if (ec != std::errc{} or ptr != last or field.empty()) return std::unexpected(RowError::BadValue);
+			return value;
+		}
+	}
+
+	//* Decode one line (without its newline) into a tuple of Ts
+	template<typename... Ts>
+	inline std::expected<std::tuple<Ts...>, RowError> decode_row(std::string_view line) {
+		std::tuple<Ts...> row;
+		RowError error{};
+		bool ok = true;
+		size_t pos = 0;
+
+		auto next_field = [&]<size_t I>(std::integral_constant<size_t, I>) {
+			if (not ok) return;
+			if (pos > line.size()) {
+				ok = false;
+				error = RowError::MissingField;
+				return;
+			}
+			std::string_view rest = line.substr(pos);
+			const void* tab = std::memchr(rest.data(), '\t', rest.size());
+			size_t len = tab ? static_cast<size_t>(static_cast<const char*>(tab) - rest.data()) : rest.size();
+
+			//? Last field must end the line, every other field must end at a tab
+			if constexpr (I + 1 == sizeof...(Ts)) {
+				if (tab) {
+					ok = false;
+					error = RowError::ExtraField;
+					return;
+				}
+			}
+			else if (not tab) {
+				ok = false;
+				error = RowError::MissingField;
+				return;
+			}
+
+			auto value = parse_field<std::tuple_element_t<I, std::tuple<Ts...>>>(rest.substr(0, len));
+			if (not value) {
+				ok = false;
+				error = value.error();
+				return;
+			}
+			std::get<I>(row) = *value;
+			pos += len + 1;
+		};
+
+		[&]<size_t... Is>(std::index_sequence<Is...>) {
+			(next_field(std::integral_constant<size_t, Is>{}), ...);
+		}(std::index_sequence_for<Ts...>{});
+
+		if (not ok) return std::unexpected(error);
+		return row;
+	}
+
+	//* Lazy range over the rows of a result, empty lines are skipped
+	template<typename... Ts>
+	class RowRange {
+	public:
+		using value_type = std::expected<std::tuple<Ts...>, RowError>;
+
+		class iterator {
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = RowRange::value_type;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() = default;
+			explicit iterator(std::string_view rest) : rest_(rest) { advance(); }
+
+			const value_type& operator*() const { return current_; }
+			const value_type* operator->() const { return &current_; }
+			iterator& operator++() { advance(); return *this; }
+			void operator++(int) { advance(); }
+			bool operator==(std::default_sentinel_t) const { return done_; }
+
+		private:
+			void advance() {
+				while (not rest_.empty()) {
+					const void* nl = std::memchr(rest_.data(), '\n', rest_.size());
+					size_t len = nl ? static_cast<size_t>(static_cast<const char*>(nl) - rest_.data()) : rest_.size();
+					std::string_view line = rest_.substr(0, len);
+					rest_.remove_prefix(nl ? len + 1 : len);
+					if (not line.empty() and line.back() == '\r') line.remove_suffix(1);
+					if (line.empty()) continue;
+					current_ = decode_row<Ts...>(line);
+					return;
+				}
+				done_ = true;
+			}
+
+			std::string_view rest_;
+			value_type current_ = std::unexpected(RowError::MissingField);
+			bool done_ = false;
+		};
+
+		explicit RowRange(std::string_view text) : text_(text) {}
+		iterator begin() const { return iterator(text_); }
+		std::default_sentinel_t end() const { return {}; }
+
+	private:
+		std::string_view text_;
+	};
+
+	template<typename... Ts>
+	inline RowRange<Ts...> rows(std::string_view text) {
+		return RowRange<Ts...>(text);
+	}
+
+	//* First row of a single column result, e.g. SELECT COUNT(*)
+	template<typename T>
+	inline std::expected<T, RowError> scalar(std::string_view text) {
+		for (const auto& row : rows<T>(text)) {
+			if (not row) return std::unexpected(row.error());
+			return std::get<0>(*row);
+		}
+		return std::unexpected(RowError::MissingField);
+	}
+
+}
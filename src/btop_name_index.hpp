@@ -0,0 +1,193 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//* Name index over the online characters, for the search prompt.
+//* Names are kept sorted by their lowercase form so a prefix is a binary search, and the lowercase
+//* names are also laid out back to back in one buffer so a substring is a single find() over it.
+//* An Index is immutable once built, rebuild() derives the next one from this cycle's positions.
+namespace Names {
+
+	//* Where an online character is this cycle
+	struct Position {
+		int guid = 0;
+		int zone = 0;
+		int level = 0;
+	};
+
+	struct Entry {
+		int guid = 0;
+		std::string name;
+		int zone = 0;
+		int level = 0;
+	};
+
+	struct Match {
+		Entry entry;
+		bool prefix = false;  // Name starts with the query, these sort first
+	};
+
+	//* ASCII lowercase, other bytes of UTF-8 names are left as they are
+	inline std::string fold(std::string_view text) {
+		std::string out(text);
+		for (auto& c : out) {
+			if (c >= 'A' and c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+		}
+		return out;
+	}
+
+	class Index {
+	public:
+		size_t size() const { return entries_.size(); }
+		bool empty() const { return entries_.empty(); }
+
+		//* Guids among positions whose name is not in the index yet
+		std::vector<int> missing(std::span<const Position> positions) const {
+			std::vector<int> guids;
+			for (const auto& p : positions) {
+				if (not by_guid_.contains(p.guid)) guids.push_back(p.guid);
+			}
+			return guids;
+		}
+
+		//* The index for this cycle: characters no longer online are dropped, the rest move to their new
+		//* zone and level, and newcomers are merged in with names from new_names (skipped when absent).
+		//* Survivors are already in order, so only the newcomers are sorted.
+		Index rebuild(std::span<const Position> positions, const std::unordered_map<int, std::string>& new_names) const {
+			struct Item {
+				std::string_view key;
+				Entry entry;
+			};
+
+			std::unordered_map<int, const Position*> online;
+			online.reserve(positions.size());
+			for (const auto& p : positions) online[p.guid] = &p;
+
+			std::vector<Item> kept;
+			kept.reserve(std::min(entries_.size(), positions.size()));
+			for (size_t i = 0; i < entries_.size(); i++) {
+				auto it = online.find(entries_[i].guid);
+				if (it == online.end()) continue;
+				Item item{key(i), entries_[i]};
+				item.entry.zone = it->second->zone;
+				item.entry.level = it->second->level;
+				kept.push_back(std::move(item));
+			}
+
+			//? Keys of the newcomers are owned here, reserved up front so the views into them stay valid
+			std::vector<std::string> fresh_keys;
+			std::vector<Item> fresh;
+			fresh_keys.reserve(positions.size());
+			for (const auto& p : positions) {
+				if (by_guid_.contains(p.guid)) continue;
+				auto name = new_names.find(p.guid);
+				if (name == new_names.end() or name->second.empty()) continue;
+				fresh_keys.push_back(fold(name->second));
+				fresh.push_back({fresh_keys.back(), {p.guid, name->second, p.zone, p.level}});
+			}
+			auto less = [](const Item& a, const Item& b) {
+				return a.key != b.key ? a.key < b.key : a.entry.guid < b.entry.guid;
+			};
+			std::sort(fresh.begin(), fresh.end(), less);
+
+			Index next;
+			const size_t count = kept.size() + fresh.size();
+			next.entries_.reserve(count);
+			next.starts_.reserve(count + 1);
+			next.by_guid_.reserve(count);
+			auto add = [&next](Item& item) {
+				if (next.by_guid_.contains(item.entry.guid)) return;
+				next.by_guid_[item.entry.guid] = next.entries_.size();
+				next.starts_.push_back(static_cast<uint32_t>(next.keys_.size()));
+				next.keys_ += item.key;
+				next.keys_ += '\n';
+				next.entries_.push_back(std::move(item.entry));
+			};
+			size_t a = 0, b = 0;
+			while (a < kept.size() or b < fresh.size()) {
+				if (b == fresh.size() or (a < kept.size() and not less(fresh[b], kept[a]))) add(kept[a++]);
+				else add(fresh[b++]);
+			}
+			next.starts_.push_back(static_cast<uint32_t>(next.keys_.size()));
+			return next;
+		}
+
+		//* Up to limit names matching query case-insensitively: prefix matches in name order,
+		//* then names containing it elsewhere, in name order
+		std::vector<Match> search(std::string_view query, size_t limit) const {
+			std::vector<Match> matches;
+			if (query.empty() or limit == 0 or entries_.empty()) return matches;
+			const std::string needle = fold(query);
+
+			auto first = lower_bound(entries_.size(), [&](size_t i) { return key(i) < needle; });
+			for (size_t i = first; i < entries_.size() and matches.size() < limit and key(i).starts_with(needle); i++) {
+				matches.push_back({entries_[i], true});
+			}
+
+			const std::string_view keys = keys_;
+			size_t from = 0;
+			while (matches.size() < limit) {
+				const size_t pos = keys.find(needle, from);
+				if (pos == std::string_view::npos) break;
+				const size_t i = static_cast<size_t>(std::upper_bound(starts_.begin(), starts_.end(), pos) - starts_.begin()) - 1;
+				if (pos != starts_[i]) matches.push_back({entries_[i], false});
+				from = starts_[i + 1];  // One match per name, prefix matches were taken above
+			}
+			return matches;
+		}
+
+		const Entry* find(int guid) const {
+			auto it = by_guid_.find(guid);
+			return it == by_guid_.end() ? nullptr : &entries_[it->second];
+		}
+
+	private:
+		std::string_view key(size_t i) const {
+			return std::string_view(keys_).substr(starts_[i], starts_[i + 1] - starts_[i] - 1);
+		}
+
+		//* First i in [0, count) where pred(i) is false, pred must be true then false
+		template<typename Pred>
+		static size_t lower_bound(size_t count, Pred pred) {
+			size_t lo = 0, hi = count;
+			while (lo < hi) {
+				const size_t mid = lo + (hi - lo) / 2;
+				if (pred(mid)) lo = mid + 1;
+				else hi = mid;
+			}
+			return lo;
+		}
+
+		std::vector<Entry> entries_;              // Sorted by lowercase name, then guid
+		std::string keys_;                        // Lowercase names in entries_ order, each followed by '\n'
+		std::vector<uint32_t> starts_;            // Offset of each key in keys_, plus one past the end
+		std::unordered_map<int, size_t> by_guid_; // guid -> position in entries_
+	};
+
+}
@@ -0,0 +1,293 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//* Streaming parser for the worldserver "server info" console output.
+//* Escape sequences are stripped while bytes are copied into a fixed line buffer, each completed
+//* line is matched against the known line shapes and numbers are read with std::from_chars.
+//* Nothing is allocated, so it is cheap enough to run on every sample.
+//*
+//* Recognised lines (after an optional "AC>" prompt):
+//*   AzerothCore rev. ece1060fa05d+ 2025-12-12 19:37:01 +0000 (Testing-Playerbot branch) (Unix, RelWithDebInfo, Static)
+//*   Connected players: 1. Characters in world: 3063.
+//*   Connection peak: 1.
+//*   Server uptime: 9 hour(s) 35 minute(s) 54 second(s)
+//*   Update time diff: 41ms. Last 500 diffs summary:
+//*   |- Mean: 120ms
+//*   |- Median: 106ms
+//*   |- Percentiles (95, 99, max): 243ms, 278ms, 314ms
+namespace ServerInfo {
+
+	//* Fixed capacity string, longer input is truncated
+	template<size_t N>
+	struct FixedString {
+		std::array<char, N> data{};
+		size_t size = 0;
+
+		void assign(std::string_view text) {
+			size = std::min(text.size(), N);
+			std::copy_n(text.data(), size, data.data());
+		}
+		std::string_view view() const { return {data.data(), size}; }
+	};
+
+	//* Which line shapes were seen
+	enum Shape : uint8_t {
+		REVISION    = 1 << 0,
+		PLAYERS     = 1 << 1,
+		PEAK        = 1 << 2,
+		UPTIME      = 1 << 3,
+		UPDATE_DIFF = 1 << 4,
+		MEAN        = 1 << 5,
+		MEDIAN      = 1 << 6,
+		PERCENTILES = 1 << 7
+	};
+
+	struct Fields {
+		FixedString<48> revision;
+		FixedString<48> branch;
+		FixedString<48> build_date;
+		FixedString<32> build_type;
+		FixedString<64> uptime;
+		int connected_players = 0;
+		int characters_in_world = 0;
+		int connection_peak = 0;
+		long long uptime_seconds = 0;
+		long long update_time_diff = 0;
+		long long mean = 0;
+		long long median = 0;
+		long long p95 = 0;
+		long long p99 = 0;
+		long long max = 0;
+		uint8_t seen = 0;  // Bitmask of Shape
+	};
+
+	namespace detail {
+		inline std::string_view trim(std::string_view text) {
+			while (not text.empty() and (text.front() == ' ' or text.front() == '\t')) text.remove_prefix(1);
+			while (not text.empty() and (text.back() == ' ' or text.back() == '\t')) text.remove_suffix(1);
+			return text;
+		}
+
+		inline bool consume(std::string_view& text, std::string_view prefix) {
+			if (not text.starts_with(prefix)) return false;
+			text.remove_prefix(prefix.size());
+			return true;
+		}
+
+		//* Read the next integer after optional spaces, advancing past it
+		template<typename T>
+		inline bool read_number(std::string_view& text, T& out) {
+			text = trim(text);
+			T value{};
+			auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+			if (ec != std::errc{}) return false;
+			text.remove_prefix(static_cast<size_t>(ptr - text.data()));
+			out = value;
+			return true;
+		}
+
+		//* Read "<n>ms", the unit is optional
+		inline bool read_ms(std::string_view& text, long long& out) {
+			if (not read_number(text, out)) return false;
+			consume(text, "ms");
+			return true;
+		}
+	}
+
+	class Parser {
+	public:
+		//* Feed a chunk of raw console output, chunks may split lines and escape sequences anywhere
+		void feed(std::string_view chunk) {
+			for (char c : chunk) put(static_cast<unsigned char>(c));
+		}
+
+		//* Flush a trailing line without newline
+		void finish() {
+			if (len_ > 0) end_line();
+			esc_ = Esc::NONE;
+		}
+
+		const Fields& fields() const { return fields_; }
+
+	private:
+		enum class Esc : uint8_t { NONE, ESC, CSI };
+
+		void put(unsigned char c) {
+			switch (esc_) {
+				case Esc::ESC:
+					// "ESC [" opens a control sequence, any other byte ends a two byte escape
+					esc_ = (c == '[') ? Esc::CSI : Esc::NONE;
+					return;
+				case Esc::CSI:
+					// Parameter and intermediate bytes until a final byte in 0x40-0x7E
+					if (c >= 0x40 and c <= 0x7E) esc_ = Esc::NONE;
+					else if (c < 0x20 or c > 0x3F) esc_ = Esc::NONE;
+					return;
+				case Esc::NONE:
+					break;
+			}
+
+			if (c == 0x1B) esc_ = Esc::ESC;
+			else if (c == '\n') end_line();
+			else if (c == '\t') append(' ');
+			else if (c >= 0x20 and c != 0x7F) append(static_cast<char>(c));
+			//? Remaining control bytes (\r, bell, backspace, ...) are dropped
+		}
+
+		void append(char c) {
+			if (len_ < line_.size()) line_[len_++] = c;
+		}
+
+		void end_line() {
+			on_line({line_.data(), len_});
+			len_ = 0;
+		}
+
+		void on_line(std::string_view line) {
+			using namespace detail;
+			line = trim(line);
+
+			//? Prompt and terminal mode leftovers, e.g. "[?2004hAC> " when the ESC byte was lost
+			while (not line.empty()) {
+				if (consume(line, "AC>")) {
+					line = trim(line);
+				}
+				else if (line.starts_with("[?")) {
+					size_t end = line.find_first_of("lh", 2);
+					if (end == std::string_view::npos) break;
+					line.remove_prefix(end + 1);
+				}
+				else break;
+			}
+			if (consume(line, "|-")) line = trim(line);
+			if (line.empty()) return;
+
+			if (consume(line, "AzerothCore rev.")) parse_revision(trim(line));
+			else if (consume(line, "Connected players:")) {
+				read_number(line, fields_.connected_players);
+				size_t pos = line.find("Characters in world:");
+				if (pos != std::string_view::npos) {
+					line.remove_prefix(pos + 20);
+					read_number(line, fields_.characters_in_world);
+				}
+				fields_.seen |= PLAYERS;
+			}
+			else if (consume(line, "Connection peak:")) {
+				if (read_number(line, fields_.connection_peak)) fields_.seen |= PEAK;
+			}
+			else if (consume(line, "Server uptime:")) parse_uptime(trim(line));
+			else if (consume(line, "Update time diff:")) {
+				if (read_ms(line, fields_.update_time_diff)) fields_.seen |= UPDATE_DIFF;
+			}
+			else if (consume(line, "Mean:")) {
+				if (read_ms(line, fields_.mean)) fields_.seen |= MEAN;
+			}
+			else if (consume(line, "Median:")) {
+				if (read_ms(line, fields_.median)) fields_.seen |= MEDIAN;
+			}
+			else if (consume(line, "Percentiles")) {
+				size_t colon = line.find(':');
+				if (colon == std::string_view::npos) return;
+				line.remove_prefix(colon + 1);
+				long long p95 = 0, p99 = 0, max = 0;
+				if (read_ms(line, p95) and consume(line, ",") and read_ms(line, p99)
+					and consume(line, ",") and read_ms(line, max)) {
+					fields_.p95 = p95;
+					fields_.p99 = p99;
+					fields_.max = max;
+					fields_.seen |= PERCENTILES;
+				}
+			}
+			//? Anything else (bot logging, "spawn docker", detach messages) is ignored
+		}
+
+		//* "ece1060fa05d+ 2025-12-12 19:37:01 +0000 (Testing-Playerbot branch) (Unix, RelWithDebInfo, Static)"
+		void parse_revision(std::string_view rest) {
+			using namespace detail;
+			size_t space = rest.find(' ');
+			fields_.revision.assign(rest.substr(0, space));
+			if (space == std::string_view::npos) {
+				fields_.seen |= REVISION;
+				return;
+			}
+			rest.remove_prefix(space + 1);
+
+			size_t open = rest.find('(');
+			fields_.build_date.assign(trim(rest.substr(0, open)));
+			if (open != std::string_view::npos) {
+				size_t close = rest.find(')', open);
+				std::string_view branch = rest.substr(open + 1, close == std::string_view::npos ? std::string_view::npos : close - open - 1);
+				if (branch.ends_with(" branch")) branch.remove_suffix(7);
+				fields_.branch.assign(branch);
+
+				//? Build type is the second entry of the last parenthesised list
+				size_t last_open = rest.rfind('(');
+				size_t last_close = rest.rfind(')');
+				if (last_open != open and last_close != std::string_view::npos and last_close > last_open) {
+					std::string_view build = rest.substr(last_open + 1, last_close - last_open - 1);
+					size_t comma = build.find(',');
+					if (comma != std::string_view::npos) {
+						build.remove_prefix(comma + 1);
+						fields_.build_type.assign(trim(build.substr(0, build.find(','))));
+					}
+				}
+			}
+			fields_.seen |= REVISION;
+		}
+
+		//* "9 hour(s) 35 minute(s) 54 second(s)", days are included once uptime passes 24 hours
+		void parse_uptime(std::string_view rest) {
+			fields_.uptime.assign(rest);
+			long long total = 0, value = 0;
+			while (detail::read_number(rest, value)) {
+				rest = detail::trim(rest);
+				if (rest.starts_with("day")) total += value * 86400;
+				else if (rest.starts_with("hour")) total += value * 3600;
+				else if (rest.starts_with("minute")) total += value * 60;
+				else if (rest.starts_with("second")) total += value;
+				size_t next = rest.find(' ');
+				if (next == std::string_view::npos) break;
+				rest.remove_prefix(next);
+			}
+			fields_.uptime_seconds = total;
+			fields_.seen |= UPTIME;
+		}
+
+		std::array<char, 512> line_{};
+		size_t len_ = 0;
+		Esc esc_ = Esc::NONE;
+		Fields fields_;
+	};
+
+	inline Fields parse(std::string_view text) {
+		Parser parser;
+		parser.feed(text);
+		parser.finish();
+		return parser.fields();
+	}
+
+}
@@ -68,6 +68,7 @@ namespace Global {
 	extern string clock;
 	extern uid_t real_uid, set_uid;
 	extern atomic<bool> init_conf;
+	extern bool debug;
 }
 
 namespace Runner {
@@ -183,7 +183,7 @@ namespace Term {
 				linebuffered(false);
 				refresh();
 
-				cout << alt_screen << hide_cursor << mouse_on << flush;
+				cout << alt_screen << hide_cursor << mouse_on << focus_on << flush;
 				Global::resized = false;
 			}
 		}
@@ -193,7 +193,7 @@ namespace Term {
 	void restore() {
 		if (initialized) {
 			tcsetattr(STDIN_FILENO, TCSANOW, &initial_settings);
-			cout << mouse_off << clear << Fx::reset << normal_screen << show_cursor << flush;
+			cout << mouse_off << focus_off << clear << Fx::reset << normal_screen << show_cursor << flush;
 			initialized = false;
 		}
 	}
@@ -406,11 +406,11 @@ namespace Tools {
 		string out;
 		const size_t mult = (bit) ? 8 : 1;
 
-		bool mega = Config::getB("base_10_sizes");
+		bool mega = Config::getB(Config::BoolKey::base_10_sizes);
 
 		// Bitrates
 	    if(bit && per_second) {
-			const auto& base_10_bitrate = Config::getS("base_10_bitrate");
+			const auto& base_10_bitrate = Config::getS(Config::StringKey::base_10_bitrate);
 			if(base_10_bitrate == "True") {
 				mega = true;
 			} else if(base_10_bitrate == "False") {
@@ -139,6 +139,8 @@ namespace Term {
 	const string mouse_off = Fx::e + "?1002l" + Fx::e + "?1015l" + Fx::e + "?1006l";
 	const string mouse_direct_on = Fx::e + "?1003h"; //? Enable reporting of mouse position at any movement
 	const string mouse_direct_off = Fx::e + "?1003l";
+	const string focus_on = Fx::e + "?1004h"; //? Enable reporting of focus in and out as ESC [ I and ESC [ O
+	const string focus_off = Fx::e + "?1004l";
 	const string sync_start = Fx::e + "?2026h"; //? Start of terminal synchronized output
 	const string sync_end = Fx::e + "?2026l"; //? End of terminal synchronized output
 
@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "btop_advisor.hpp"
+
+namespace {
+
+	//* EXPLAIN FORMAT=JSON of the bot count query on an unindexed characters table, as `mysql -sN` prints it
+	constexpr std::string_view full_scan_explain =
+		R"x({\n  "query_block": {\n    "select_id": 1,\n    "cost_info": {\n      "query_cost": "1274.35"\n    },\n)x"
+		R"x(    "table": {\n      "table_name": "characters",\n      "access_type": "ALL",\n      "rows_examined_per_scan": 12093,\n)x"
+		R"x(      "rows_produced_per_join": 1209,\n      "filtered": "10.00",\n      "cost_info": {\n        "read_cost": "1153.42",\n)x"
+		R"x(        "eval_cost": "120.93",\n        "prefix_cost": "1274.35",\n        "data_read_per_join": "2M"\n      },\n)x"
+		R"x(      "used_columns": [\n        "guid",\n        "account",\n        "online"\n      ],\n)x"
+		R"x(      "attached_condition": "((`acore_characters`.`characters`.`online` = 1) and (`acore_characters`.`characters`.`account` not in (1,2,3)))"\n)x"
+		R"x(    }\n  }\n})x";
+
+	//* The continents query: a grouped derived table read back with a filesort
+	constexpr std::string_view derived_explain = R"({
+  "query_block": {
+    "select_id": 1,
+    "cost_info": { "query_cost": "58.12" },
+    "ordering_operation": {
+      "using_filesort": true,
+      "grouping_operation": {
+        "using_temporary_table": true,
+        "using_filesort": false,
+        "table": {
+          "table_name": "map_counts",
+          "access_type": "ALL",
+          "rows_examined_per_scan": 42,
+          "materialized_from_subquery": {
+            "using_temporary_table": true,
+            "query_block": {
+              "select_id": 2,
+              "cost_info": { "query_cost": "20.50" },
+              "grouping_operation": {
+                "using_filesort": false,
+                "table": {
+                  "table_name": "characters",
+                  "access_type": "ref",
+                  "possible_keys": ["idx_online", "idx_bottop_online_map_account"],
+                  "key": "idx_bottop_online_map_account",
+                  "rows_examined_per_scan": 3063,
+                  "filtered": "90.00",
+                  "using_index": true
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+})";
+
+	Advisor::QuerySpec bot_count_spec() {
+		return {"bot_count", "SELECT COUNT(*) FROM characters WHERE online = 1;", "characters", {"online"}, {}, {"account"}};
+	}
+
+	Advisor::QuerySpec zone_spec() {
+		return {"zone_histogram", "SELECT zone, level, COUNT(*) FROM characters WHERE online = 1 GROUP BY zone, level;",
+			"characters", {"online"}, {"zone", "level"}, {"race", "account"}};
+	}
+
+}
+
+TEST(advisor, parses_batch_escaped_full_scan) {
+	auto plan = Advisor::parse_explain(Advisor::unescape_batch(full_scan_explain));
+	ASSERT_TRUE(plan.valid);
+	EXPECT_DOUBLE_EQ(plan.query_cost, 1274.35);
+	ASSERT_EQ(plan.tables.size(), 1u);
+	EXPECT_EQ(plan.tables[0].table, "characters");
+	EXPECT_EQ(plan.tables[0].access_type, "ALL");
+	EXPECT_TRUE(plan.tables[0].key.empty());
+	EXPECT_EQ(plan.rows(), 12093);
+	EXPECT_DOUBLE_EQ(plan.tables[0].filtered, 10.0);
+
+	auto problems = Advisor::find_problems(plan);
+	ASSERT_EQ(problems.size(), 1u);
+	EXPECT_EQ(problems[0], "full scan of characters");
+}
+
+TEST(advisor, derived_tables_are_not_problems) {
+	auto plan = Advisor::parse_explain(derived_explain);
+	ASSERT_TRUE(plan.valid);
+	EXPECT_DOUBLE_EQ(plan.query_cost, 58.12);
+	ASSERT_EQ(plan.tables.size(), 2u);
+	EXPECT_TRUE(plan.tables[0].derived);
+	EXPECT_FALSE(plan.tables[1].derived);
+	EXPECT_EQ(plan.tables[1].key, "idx_bottop_online_map_account");
+	EXPECT_EQ(plan.tables[1].possible_keys.size(), 2u);
+	EXPECT_TRUE(plan.tables[1].using_index);
+	EXPECT_EQ(plan.rows(), 3063);
+	EXPECT_TRUE(plan.filesort);
+	EXPECT_TRUE(plan.temporary);
+
+	auto problems = Advisor::find_problems(plan);
+	ASSERT_EQ(problems.size(), 2u);
+	EXPECT_EQ(problems[0], "temporary table");
+	EXPECT_EQ(problems[1], "filesort");
+}
+
+TEST(advisor, malformed_explain_is_invalid) {
+	for (std::string_view input : {"", "ERROR 1064 (42000): You have an error in your SQL syntax", "{\"query_block\": {",
+			"{\"table\": {\"table_name\": }}", "{} trailing"}) {
+		EXPECT_FALSE(Advisor::parse_explain(input).valid) << input;
+	}
+	std::string deep(500, '[');
+	EXPECT_FALSE(Advisor::parse_explain(deep).valid);
+}
+
+TEST(advisor, existing_indexes) {
+	auto indexes = Advisor::parse_indexes(
+		"1\tacore_characters\tcharacters\tPRIMARY\t1\tguid\n"
+		"1\tacore_characters\tcharacters\tidx_online\t1\tonline\n"
+		"1\tacore_characters\tcharacters\tidx_zone\t1\tonline\n"
+		"1\tacore_characters\tcharacters\tidx_zone\t2\tzone\n"
+		"1\tacore_characters\tcharacters\tidx_zone\t3\tlevel\n"
+		"1\tacore_characters\tcharacters\tidx_zone\t4\taccount\n"
+		"1\tacore_characters\tcharacters\tidx_zone\t5\trace\n"
+		"0\tacore_auth\taccount\tidx_username\t1\tusername\n");
+	ASSERT_EQ(indexes["characters"].size(), 3u);
+	ASSERT_EQ(indexes["acore_auth.account"].size(), 1u);
+
+	const auto& zone_index = indexes["characters"][2];
+	EXPECT_EQ(zone_index.name, "idx_zone");
+	EXPECT_TRUE(Advisor::index_serves(zone_index, zone_spec()));
+	EXPECT_FALSE(Advisor::index_serves(indexes["characters"][1], zone_spec()));
+	//? Leading columns must match in order, covering columns may sit anywhere after them
+	EXPECT_FALSE(Advisor::index_serves({"idx", {"zone", "online", "level", "race", "account"}}, zone_spec()));
+	EXPECT_TRUE(Advisor::index_serves({"idx", {"online", "account", "level"}}, bot_count_spec()));
+}
+
+TEST(advisor, suggestions_are_ranked_by_cost) {
+	auto cheap = bot_count_spec();
+	auto costly = zone_spec();
+	int runs = 0;
+	Advisor::Exec exec = [&](const std::string& sql) -> std::string {
+		if (sql.starts_with("SELECT TABLE_SCHEMA")) return "1\tacore_characters\tcharacters\tPRIMARY\t1\tguid\n";
+		if (sql.starts_with("EXPLAIN")) return std::string(full_scan_explain) + "\n";
+		runs++;
+		//? Make the zone query measurably slower than the count
+		if (sql == costly.sql) {
+			auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(5);
+			while (std::chrono::steady_clock::now() < until) {}
+		}
+		return "1\n";
+	};
+
+	auto report = Advisor::run({cheap, costly}, exec, 2);
+	ASSERT_TRUE(report.error.empty());
+	EXPECT_EQ(runs, 4);
+	ASSERT_EQ(report.queries.size(), 2u);
+	ASSERT_EQ(report.suggestions.size(), 2u);
+	EXPECT_EQ(report.suggestions[0].queries, std::vector<std::string>{"zone_histogram"});
+	EXPECT_EQ(report.suggestions[0].ddl(),
+		"CREATE INDEX idx_bottop_online_zone_level_race_account ON characters (online, zone, level, race, account);");
+	EXPECT_EQ(report.suggestions[1].ddl(), "CREATE INDEX idx_bottop_online_account ON characters (online, account);");
+	EXPECT_GE(report.suggestions[0].cost_ms, report.suggestions[1].cost_ms);
+
+	auto lines = report.lines(false);
+	EXPECT_NE(lines.back().find("idx_bottop_online_account"), std::string::npos);
+}
+
+TEST(advisor, existing_index_suppresses_suggestion) {
+	Advisor::Exec exec = [](const std::string& sql) -> std::string {
+		if (sql.starts_with("SELECT TABLE_SCHEMA")) return "1\tacore_characters\tcharacters\tidx_count\t1\tonline\n"
+			"1\tacore_characters\tcharacters\tidx_count\t2\taccount\n";
+		if (sql.starts_with("EXPLAIN")) return std::string(full_scan_explain);
+		return "1\n";
+	};
+	auto report = Advisor::run({bot_count_spec()}, exec, 1);
+	EXPECT_TRUE(report.suggestions.empty());
+	ASSERT_EQ(report.queries.size(), 1u);
+	EXPECT_FALSE(report.queries[0].problems.empty());
+}
+
+TEST(advisor, unreachable_database_reports_error) {
+	auto report = Advisor::run({bot_count_spec()}, [](const std::string&) { return std::string(); });
+	EXPECT_FALSE(report.error.empty());
+	ASSERT_EQ(report.lines().size(), 1u);
+}
+
+//* Against a real MySQL with a characters table, e.g.
+//* BOTTOP_TEST_MYSQL="mysql -h127.0.0.1 -uroot -ppassword acore_characters"
+TEST(advisor, live_mysql_fixture) {
+	const char* command = std::getenv("BOTTOP_TEST_MYSQL");
+	if (command == nullptr) GTEST_SKIP() << "BOTTOP_TEST_MYSQL not set";
+
+	Advisor::Exec exec = [&](const std::string& sql) {
+		std::string out;
+		std::string escaped;
+		for (char c : sql) {
+			if (c == '\'') escaped += "'\\''";
+			else escaped += c;
+		}
+		FILE* pipe = popen((std::string(command) + " -sN -e '" + escaped + "' 2>/dev/null").c_str(), "r");
+		if (pipe == nullptr) return out;
+		char buf[4096];
+		while (size_t n = fread(buf, 1, sizeof(buf), pipe)) out.append(buf, n);
+		pclose(pipe);
+		return out;
+	};
+
+	auto report = Advisor::run({bot_count_spec(), zone_spec()}, exec, 1);
+	ASSERT_TRUE(report.error.empty()) << report.error;
+	for (const auto& q : report.queries) EXPECT_TRUE(q.plan.valid) << q.name;
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Micro-benchmarks for the collector's output parsers, comparing them against the
+// istringstream/getline/stoi code they replaced. Not part of ctest, run btop_bench by hand.
+
+#include <chrono>
+#include <cstdio>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "btop_mysql_rows.hpp"
+#include "btop_serverinfo.hpp"
+#include "server_info_transcripts.hpp"
+
+namespace {
+
+	//* Zone rows shaped like fetch_zones output: zone, total, min level, max level
+	std::string make_zone_rows(int count) {
+		std::string out;
+		for (int i = 0; i < count; i++) {
+			out += std::to_string(100 + i * 7) + '\t' + std::to_string(20 + i % 400) + '\t'
+				+ std::to_string(1 + i % 70) + '\t' + std::to_string(10 + i % 71) + '\n';
+		}
+		return out;
+	}
+
+	//* Previous fetch_zones parsing
+	long long legacy_zone_rows(const std::string& result) {
+		long long sum = 0;
+		std::istringstream stream(result);
+		std::string line;
+		while (std::getline(stream, line)) {
+			std::istringstream line_stream(line);
+			std::string zone_id_str, total_str, min_str, max_str;
+			if (std::getline(line_stream, zone_id_str, '\t') &&
+				std::getline(line_stream, total_str, '\t') &&
+				std::getline(line_stream, min_str, '\t') &&
+				std::getline(line_stream, max_str)) {
+				sum += std::stoi(zone_id_str) + std::stoi(total_str) + std::stoi(min_str) + std::stoi(max_str);
+			}
+		}
+		return sum;
+	}
+
+	long long typed_zone_rows(std::string_view result) {
+		long long sum = 0;
+		for (const auto& row : Mysql::rows<int, int, int, int>(result)) {
+			if (not row) continue;
+			auto [zone, total, min_level, max_level] = *row;
+			sum += zone + total + min_level + max_level;
+		}
+		return sum;
+	}
+
+	//* Previous fetch_server_performance parsing: regex strip, re-stream to filter, find/substr/stoll per line
+	long long legacy_server_info(std::string result) {
+		std::regex ansi_regex("\033\\[[0-9;]*[mKH]|\\[\\?[0-9]+[lh]");
+		result = std::regex_replace(result, ansi_regex, "");
+
+		std::istringstream pre_stream(result);
+		std::ostringstream filtered;
+		std::string line;
+		while (std::getline(pre_stream, line)) {
+			if (line.find("[BotLevelBrackets]") != std::string::npos || line.find("AHBot") != std::string::npos ||
+				line.find("spawn docker") != std::string::npos || line.find("read escape sequence") != std::string::npos) continue;
+			filtered << line << "\n";
+		}
+
+		auto ms_value = [](std::string value) -> long long {
+			size_t ms_pos = value.find("ms");
+			if (ms_pos == std::string::npos) return 0;
+			value = value.substr(0, ms_pos);
+			value.erase(0, value.find_first_not_of(" \t"));
+			value.erase(value.find_last_not_of(" \t") + 1);
+			return std::stoll(value);
+		};
+
+		long long sum = 0;
+		std::istringstream stream(filtered.str());
+		while (std::getline(stream, line)) {
+			if (line.find("AC>") == 0) {
+				line = line.substr(3);
+				line.erase(0, line.find_first_not_of(" \t"));
+			}
+			if (line.empty()) continue;
+			if (line.find("Connected players:") != std::string::npos) {
+				std::string rest = line.substr(line.find("Characters in world:") + 20);
+				sum += std::stoi(rest.substr(0, rest.find('.')));
+			}
+			else if (line.find("Update time diff:") != std::string::npos) sum += ms_value(line.substr(line.find(':') + 1));
+			else if (line.find("Mean:") != std::string::npos) sum += ms_value(line.substr(line.find(':') + 1));
+			else if (line.find("Median:") != std::string::npos) sum += ms_value(line.substr(line.find(':') + 1));
+			else if (line.find("Percentiles") != std::string::npos) {
+				std::istringstream values(line.substr(line.find(':') + 1));
+				std::string p95, p99, max;
+				if (std::getline(values, p95, ',') && std::getline(values, p99, ',') && std::getline(values, max, ','))
+					sum += ms_value(p95) + ms_value(p99) + ms_value(max);
+			}
+		}
+		return sum;
+	}
+
+	long long streaming_server_info(std::string_view result) {
+		auto f = ServerInfo::parse(result);
+		return f.characters_in_world + f.update_time_diff + f.mean + f.median + f.p95 + f.p99 + f.max;
+	}
+
+	template<typename F>
+	double time_per_call_us(F&& fn, int iterations, long long& sink) {
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++) sink += fn();
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+	}
+
+}
+
+int main() {
+	long long sink = 0;
+	const int iterations = 2000;
+
+	for (int rows : {50, 500, 5000}) {
+		const std::string result = make_zone_rows(rows);
+		if (legacy_zone_rows(result) != typed_zone_rows(result)) {
+			std::fprintf(stderr, "zone rows: parsers disagree\n");
+			return 1;
+		}
+		double legacy = time_per_call_us([&] { return legacy_zone_rows(result); }, iterations, sink);
+		double typed = time_per_call_us([&] { return typed_zone_rows(result); }, iterations, sink);
+		std::printf("zone rows x%-5d  istringstream %9.2f us  Mysql::rows %9.2f us  (%.1fx)\n",
+			rows, legacy, typed, legacy / typed);
+	}
+
+	for (auto transcript : Transcripts::all) {
+		const std::string capture(transcript);
+		if (legacy_server_info(capture) != streaming_server_info(capture)) {
+			std::fprintf(stderr, "server info: parsers disagree\n");
+			return 1;
+		}
+		double legacy = time_per_call_us([&] { return legacy_server_info(capture); }, iterations, sink);
+		double streaming = time_per_call_us([&] { return streaming_server_info(capture); }, iterations, sink);
+		std::printf("server info %4zuB  regex+find    %9.2f us  ServerInfo  %9.2f us  (%.1fx)\n",
+			capture.size(), legacy, streaming, legacy / streaming);
+	}
+
+	return sink == 42 ? 2 : 0;
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "btop_config.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+	//* A config file of its own per test, written again with a later mtime so modified() sees every write
+	class ConfigFile {
+	public:
+		explicit ConfigFile(const std::string& name) : path(fs::temp_directory_path() / ("bottop_" + name + ".conf")) {}
+		~ConfigFile() {
+			std::error_code error;
+			fs::remove(path, error);
+		}
+
+		void write(const std::string& body) {
+			const bool existed = fs::exists(path);
+			const auto before = existed ? fs::last_write_time(path) : fs::file_time_type{};
+			std::ofstream(path) << "#? Config file for bottop\n" << body;
+			if (existed) fs::last_write_time(path, before + std::chrono::seconds(1));
+		}
+
+		fs::path path;
+	};
+
+	bool has(const std::vector<std::string_view>& names, std::string_view name) {
+		return std::ranges::find(names, name) != names.end();
+	}
+
+}
+
+TEST(config, reload_sets_only_changed_keys) {
+	ConfigFile file("reload");
+	std::vector<std::string> warnings;
+	file.write("color_theme = \"Default\"\nupdate_ms = 2000\ntruecolor = True\n");
+	Config::load(file.path, warnings);
+	ASSERT_EQ(Config::getI("update_ms"), 2000);
+	EXPECT_FALSE(Config::modified(file.path));
+
+	//? Set at runtime, e.g. from the options menu, and not in the file
+	Config::set("proc_sorting", std::string("memory"));
+	EXPECT_TRUE(Config::reload(file.path, warnings).empty());
+	EXPECT_EQ(Config::getS("proc_sorting"), "memory");
+
+	file.write("color_theme = \"Nord\"\nupdate_ms = 3000\ntruecolor = True\n");
+	EXPECT_TRUE(Config::modified(file.path));
+	const auto changed = Config::reload(file.path, warnings);
+	EXPECT_EQ(changed.size(), 2u);
+	EXPECT_TRUE(has(changed, "color_theme"));
+	EXPECT_TRUE(has(changed, "update_ms"));
+	EXPECT_FALSE(Config::modified(file.path));
+
+	EXPECT_EQ(Config::getI("update_ms"), 3000);
+	EXPECT_EQ(Config::getS("color_theme"), "Nord");
+	EXPECT_TRUE(Config::getB("truecolor"));
+	EXPECT_EQ(Config::getS("proc_sorting"), "memory");
+	EXPECT_TRUE(warnings.empty());
+}
+
+TEST(config, reload_skips_invalid_values) {
+	ConfigFile file("invalid");
+	std::vector<std::string> warnings;
+	file.write("update_ms = 2000\n");
+	Config::load(file.path, warnings);
+
+	file.write("update_ms = 10\n");
+	EXPECT_TRUE(Config::reload(file.path, warnings).empty());
+	EXPECT_EQ(Config::getI("update_ms"), 2000);
+	EXPECT_FALSE(warnings.empty());
+}
+
+TEST(config, watch_changed) {
+	Config::set("update_ms", 2000);
+	Config::Watch update_ms(Config::IntKey::update_ms);
+	EXPECT_EQ(update_ms.value(), 2000);
+	EXPECT_FALSE(update_ms.changed());
+
+	Config::set("update_ms", 1500);
+	EXPECT_TRUE(update_ms.changed());
+	EXPECT_EQ(update_ms.value(), 1500);
+	EXPECT_FALSE(update_ms.changed());
+
+	//? Setting the same value, or another key, moves the generation but changes nothing
+	Config::set("update_ms", 1500);
+	Config::set("proc_sorting", std::string("cpu lazy"));
+	EXPECT_FALSE(update_ms.changed());
+	EXPECT_EQ(Config::getI(Config::IntKey::update_ms), 1500);
+}
+
+TEST(config, watch_sees_reload) {
+	ConfigFile file("watch");
+	std::vector<std::string> warnings;
+	file.write("graph_symbol = \"braille\"\n");
+	Config::load(file.path, warnings);
+	Config::Watch graph_symbol(Config::StringKey::graph_symbol);
+
+	file.write("graph_symbol = \"block\"\n");
+	Config::reload(file.path, warnings);
+	EXPECT_TRUE(graph_symbol.changed());
+	EXPECT_EQ(graph_symbol.value(), "block");
+}
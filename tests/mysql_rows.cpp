@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "btop_mysql_rows.hpp"
+
+TEST(mysql_rows, decodes_typed_rows) {
+	std::vector<std::tuple<int, int, int, int>> decoded;
+	for (const auto& row : Mysql::rows<int, int, int, int>("12\t340\t1\t10\n1519\t77\t5\t60\n")) {
+		ASSERT_TRUE(row.has_value());
+		decoded.push_back(*row);
+	}
+	auto expected = std::vector<std::tuple<int, int, int, int>> { {12, 340, 1, 10}, {1519, 77, 5, 60} };
+	EXPECT_EQ(decoded, expected);
+}
+
+TEST(mysql_rows, string_fields_are_views_into_input) {
+	std::string_view text = "Eastern Kingdoms\t1200\r\nKalimdor\t900";
+	std::vector<std::string_view> names;
+	for (const auto& row : Mysql::rows<std::string_view, int>(text)) {
+		ASSERT_TRUE(row.has_value());
+		auto [name, count] = *row;
+		EXPECT_GE(name.data(), text.data());
+		EXPECT_LE(name.data() + name.size(), text.data() + text.size());
+		names.push_back(name);
+	}
+	EXPECT_EQ(names, (std::vector<std::string_view> { "Eastern Kingdoms", "Kalimdor" }));
+}
+
+TEST(mysql_rows, bad_rows_are_reported_not_thrown) {
+	std::vector<Mysql::RowError> errors;
+	int good = 0;
+	for (const auto& row : Mysql::rows<int, double>("1\t2.5\nNULL\t3\n4\n5\t6\t7\n\n8\t9\n")) {
+		if (row) good++;
+		else errors.push_back(row.error());
+	}
+	EXPECT_EQ(good, 2);
+	auto expected = std::vector<Mysql::RowError> {
+		Mysql::RowError::BadValue, Mysql::RowError::MissingField, Mysql::RowError::ExtraField
+	};
+	EXPECT_EQ(errors, expected);
+}
+
+TEST(mysql_rows, scalar) {
+	EXPECT_EQ(Mysql::scalar<int>("3063\n").value_or(-1), 3063);
+	EXPECT_EQ(Mysql::scalar<std::string_view>("1,2,3\n").value_or(""), "1,2,3");
+	EXPECT_FALSE(Mysql::scalar<int>("").has_value());
+	EXPECT_FALSE(Mysql::scalar<int>("NULL\n").has_value());
+}
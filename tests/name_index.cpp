@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "btop_name_index.hpp"
+
+namespace {
+
+	Names::Index build(const std::vector<std::pair<int, std::string>>& bots) {
+		std::vector<Names::Position> positions;
+		std::unordered_map<int, std::string> names;
+		for (const auto& [guid, name] : bots) {
+			positions.push_back({guid, guid % 7, guid % 80 + 1});
+			names[guid] = name;
+		}
+		return Names::Index{}.rebuild(positions, names);
+	}
+
+	std::vector<std::string> names_of(const std::vector<Names::Match>& matches) {
+		std::vector<std::string> out;
+		for (const auto& m : matches) out.push_back(m.entry.name);
+		return out;
+	}
+
+}
+
+TEST(name_index, prefix_before_substring) {
+	auto index = build({{1, "Thrall"}, {2, "Arthas"}, {3, "Thalnos"}, {4, "Garrosh"}, {5, "thaurissan"}, {6, "Jaina"}});
+	ASSERT_EQ(index.size(), 6u);
+
+	auto matches = index.search("THA", 10);
+	EXPECT_EQ(names_of(matches), (std::vector<std::string>{"Thalnos", "thaurissan", "Arthas"}));
+	EXPECT_TRUE(matches[0].prefix);
+	EXPECT_FALSE(matches[2].prefix);
+
+	EXPECT_EQ(names_of(index.search("a", 2)), (std::vector<std::string>{"Arthas", "Garrosh"}));
+	EXPECT_TRUE(index.search("", 10).empty());
+	EXPECT_TRUE(index.search("xyz", 10).empty());
+	//? Matches never span two names
+	EXPECT_TRUE(index.search("shja", 10).empty());
+}
+
+TEST(name_index, rebuild_is_incremental) {
+	auto index = build({{1, "Thrall"}, {2, "Arthas"}, {3, "Jaina"}});
+
+	std::vector<Names::Position> next = {{1, 1637, 80}, {3, 1519, 79}, {9, 12, 5}, {10, 14, 6}};
+	auto missing = index.missing(next);
+	EXPECT_EQ(missing, (std::vector<int>{9, 10}));
+
+	//? Names are only needed for newcomers, and one without a name is left out until it has one
+	auto updated = index.rebuild(next, {{9, "Anduin"}});
+	ASSERT_EQ(updated.size(), 3u);
+	EXPECT_EQ(updated.find(2), nullptr);
+	ASSERT_NE(updated.find(1), nullptr);
+	EXPECT_EQ(updated.find(1)->zone, 1637);
+	EXPECT_EQ(updated.find(1)->level, 80);
+	EXPECT_EQ(updated.missing(next), std::vector<int>{10});
+	EXPECT_EQ(names_of(updated.search("a", 10)), (std::vector<std::string>{"Anduin", "Jaina", "Thrall"}));
+}
+
+TEST(name_index, fast_over_many_names) {
+	std::vector<std::pair<int, std::string>> bots;
+	const char* syllables[] = {"ka", "lo", "thr", "mi", "zan", "dor", "el", "gar", "os", "ri", "ven", "ul"};
+	for (int guid = 1; guid <= 20000; guid++) {
+		std::string name;
+		for (int n = guid; n > 0; n /= 12) name += syllables[n % 12];
+		name[0] = static_cast<char>(name[0] - 'a' + 'A');
+		bots.push_back({guid, name});
+	}
+	auto index = build(bots);
+	ASSERT_EQ(index.size(), 20000u);
+
+	auto start = std::chrono::steady_clock::now();
+	size_t found = 0;
+	for (const char* query : {"k", "Thr", "zanka", "osri", "ulul", "nothing"}) found += index.search(query, 50).size();
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	EXPECT_GT(found, 0u);
+	//? Six searches, generous enough for unoptimized and sanitizer builds
+	EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 50);
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "btop_serverinfo.hpp"
+#include "server_info_transcripts.hpp"
+
+TEST(server_info, parses_playerbot_transcript) {
+	auto f = ServerInfo::parse(Transcripts::playerbot_testing);
+	EXPECT_EQ(f.seen, 0xFF);
+	EXPECT_EQ(f.revision.view(), "ece1060fa05d+");
+	EXPECT_EQ(f.build_date.view(), "2025-12-12 19:37:01 +0000");
+	EXPECT_EQ(f.branch.view(), "Testing-Playerbot");
+	EXPECT_EQ(f.build_type.view(), "RelWithDebInfo");
+	EXPECT_EQ(f.connected_players, 1);
+	EXPECT_EQ(f.characters_in_world, 3063);
+	EXPECT_EQ(f.connection_peak, 1);
+	EXPECT_EQ(f.uptime.view(), "9 hour(s) 35 minute(s) 54 second(s)");
+	EXPECT_EQ(f.uptime_seconds, 9 * 3600 + 35 * 60 + 54);
+	EXPECT_EQ(f.update_time_diff, 41);
+	EXPECT_EQ(f.mean, 120);
+	EXPECT_EQ(f.median, 106);
+	EXPECT_EQ(f.p95, 243);
+	EXPECT_EQ(f.p99, 278);
+	EXPECT_EQ(f.max, 314);
+}
+
+TEST(server_info, parses_day_uptime) {
+	auto f = ServerInfo::parse(Transcripts::long_uptime_release);
+	EXPECT_EQ(f.seen, 0xFF);
+	EXPECT_EQ(f.branch.view(), "master");
+	EXPECT_EQ(f.build_type.view(), "Release");
+	EXPECT_EQ(f.uptime_seconds, 2 * 86400 + 4 * 3600 + 17);
+	EXPECT_EQ(f.max, 1022);
+}
+
+TEST(server_info, chunking_does_not_change_result) {
+	std::mt19937 rng(1234);
+	for (auto transcript : Transcripts::all) {
+		auto whole = ServerInfo::parse(transcript);
+		for (int round = 0; round < 200; round++) {
+			ServerInfo::Parser parser;
+			size_t pos = 0;
+			while (pos < transcript.size()) {
+				size_t len = std::uniform_int_distribution<size_t>(1, 17)(rng);
+				parser.feed(transcript.substr(pos, len));
+				pos += len;
+			}
+			parser.finish();
+			const auto& f = parser.fields();
+			ASSERT_EQ(f.seen, whole.seen);
+			ASSERT_EQ(f.revision.view(), whole.revision.view());
+			ASSERT_EQ(f.characters_in_world, whole.characters_in_world);
+			ASSERT_EQ(f.p99, whole.p99);
+		}
+	}
+}
+
+TEST(server_info, fuzzed_input_is_bounded) {
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int> byte(0, 255);
+	for (auto transcript : Transcripts::all) {
+		for (int round = 0; round < 2000; round++) {
+			std::string input(transcript);
+			int mutations = std::uniform_int_distribution<int>(1, 40)(rng);
+			for (int m = 0; m < mutations; m++) {
+				size_t at = std::uniform_int_distribution<size_t>(0, input.size() - 1)(rng);
+				switch (rng() % 3) {
+					case 0: input[at] = static_cast<char>(byte(rng)); break;
+					case 1: input.insert(at, 1, static_cast<char>(byte(rng))); break;
+					default: input.erase(at, 1); break;
+				}
+			}
+			auto f = ServerInfo::parse(input);
+			ASSERT_LE(f.revision.size, f.revision.data.size());
+			ASSERT_LE(f.uptime.size, f.uptime.data.size());
+		}
+	}
+
+	//? Pure noise and a line far longer than the buffer
+	std::string noise(1 << 16, '\0');
+	for (auto& c : noise) c = static_cast<char>(byte(rng));
+	ServerInfo::parse(noise);
+	auto f = ServerInfo::parse("|- Mean: " + std::string(4096, '9') + "ms\n");
+	EXPECT_EQ(f.seen & ServerInfo::MEAN, 0);
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// "server info" captures from the expect/docker attach session used by fetch_server_performance,
+// kept byte for byte including prompts, colour codes, CRLF line ends and interleaved bot logging.
+
+#pragma once
+
+#include <array>
+#include <string_view>
+
+namespace Transcripts {
+
+	inline constexpr std::string_view playerbot_testing =
+		"spawn docker attach testing-ac-worldserver\r\n"
+		"\r\n"
+		"\x1b[?2004hAC> \x1b[?2004l\r\n"
+		"\x1b[1;32m[BotLevelBrackets]\x1b[0m Alliance bracket 3 over target, relocating 4 bots\r\n"
+		"\x1b[?2004hAC> server info\r\n"
+		"\x1b[?2004l\r"
+		"AzerothCore rev. ece1060fa05d+ 2025-12-12 19:37:01 +0000 (Testing-Playerbot branch) (Unix, RelWithDebInfo, Static)\r\n"
+		"Connected players: 1. Characters in world: 3063.\r\n"
+		"Connection peak: 1.\r\n"
+		"Server uptime: 9 hour(s) 35 minute(s) 54 second(s)\r\n"
+		"Update time diff: 41ms. Last 500 diffs summary:\r\n"
+		"|- Mean: 120ms\r\n"
+		"AHBot: Seller run for 12 items took 3 ms\r\n"
+		"|- Median: 106ms\r\n"
+		"|- Percentiles (95, 99, max): 243ms, 278ms, 314ms\r\n"
+		"\x1b[?2004hAC> read escape sequence\r\n";
+
+	inline constexpr std::string_view long_uptime_release =
+		"spawn docker attach ac-worldserver\n"
+		"AC> server info\n"
+		"\x1b[0mAzerothCore rev. 5e7a3d1c9b20 2025-11-02 08:14:55 +0000 (master branch) (Unix, Release, Static)\n"
+		"Connected players: 0. Characters in world: 12480.\n"
+		"Connection peak: 3.\n"
+		"Server uptime: 2 day(s) 4 hour(s) 0 minute(s) 17 second(s)\n"
+		"Update time diff: 187ms. Last 500 diffs summary:\n"
+		"|- Mean: 163ms\n"
+		"|- Median: 158ms\n"
+		"|- Percentiles (95, 99, max): 301ms, 415ms, 1022ms\n"
+		"AC> ";
+
+	inline constexpr std::array all = { playerbot_testing, long_uptime_release };
+
+}